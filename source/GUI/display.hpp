@@ -80,7 +80,7 @@ namespace hummus {
         
     	// ----- PUBLIC DISPLAY METHODS -----
 		void incoming_spike(double timestamp, Synapse* s, Neuron* postsynaptic_neuron, Network* network) override {
-            dynamics_viewer->handle_data(timestamp, postsynaptic_neuron->get_neuron_id(), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
+            dynamics_viewer->handle_data(timestamp, network->get_user_id(postsynaptic_neuron->get_neuron_id()), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
             
             if (output_viewer->get_layer_changed()) {
                 engine->rootContext()->setContextProperty("sublayers", static_cast<int>(output_viewer->get_y_lookup()[output_viewer->get_layer_tracker()].size()-1));
@@ -91,16 +91,16 @@ namespace hummus {
         void neuron_fired(double timestamp, Synapse* s, Neuron* postsynaptic_neuron, Network* network) override {
             // so decision-making neurons which do not pass synapses don't crash
             if (s) {
-                input_viewer->handle_data(timestamp, s->get_presynaptic_neuron_id(), postsynaptic_neuron->get_neuron_id(), postsynaptic_neuron->get_sublayer_id());
+                input_viewer->handle_data(timestamp, network->get_user_id(s->get_presynaptic_neuron_id()), network->get_user_id(postsynaptic_neuron->get_neuron_id()), postsynaptic_neuron->get_sublayer_id());
             }
-			output_viewer->handle_data(timestamp, postsynaptic_neuron->get_neuron_id(), postsynaptic_neuron->get_layer_id(), postsynaptic_neuron->get_sublayer_id());
-            dynamics_viewer->handle_data(timestamp, postsynaptic_neuron->get_neuron_id(), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
+			output_viewer->handle_data(timestamp, network->get_user_id(postsynaptic_neuron->get_neuron_id()), postsynaptic_neuron->get_layer_id(), postsynaptic_neuron->get_sublayer_id());
+            dynamics_viewer->handle_data(timestamp, network->get_user_id(postsynaptic_neuron->get_neuron_id()), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
 		}
 
 		void status_update(double timestamp, Neuron* postsynaptic_neuron, Network* network) override {
             input_viewer->handle_update(timestamp);
             output_viewer->handle_update(timestamp);
-            dynamics_viewer->handle_data(timestamp, postsynaptic_neuron->get_neuron_id(), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
+            dynamics_viewer->handle_data(timestamp, network->get_user_id(postsynaptic_neuron->get_neuron_id()), postsynaptic_neuron->get_potential(), postsynaptic_neuron->get_current(), postsynaptic_neuron->get_threshold());
 		}
 
 		void begin(Network* network, std::mutex* sync) override {
@@ -11,19 +11,34 @@
 
 #pragma once
 
+#include <cstdint>
+#include <initializer_list>
+
 #include "synapse.hpp"
 
 namespace hummus {
     class Synapse;
     class Neuron;
     class Network;
+
+    // messages sent by the neurons for every event. an addon only receives the ones it subscribed to
+    enum class addon_hook : std::uint8_t {
+        incoming_spike,
+        neuron_fired,
+        status_update,
+        learn
+    };
+
+    constexpr std::size_t number_of_addon_hooks = 4;
     
 	// polymorphic class for addons
 	class Addon {
         
 	public:
 		// ----- CONSTRUCTOR AND DESTRUCTOR -----
-        Addon() : do_not_automatically_include(false) {}
+        Addon() :
+                do_not_automatically_include(false),
+                subscribed_hooks((1u << number_of_addon_hooks) - 1) {}
 		virtual ~Addon(){}
 		
 		// ----- PUBLIC METHODS -----
@@ -61,6 +76,18 @@ namespace hummus {
         // select which neurons the addon is active on
         virtual void activate_for(std::vector<size_t> neuronIdx){};
         
+        // bytes used by the addon. addons holding large buffers should add them to this estimate
+        virtual std::size_t get_memory_footprint() const {
+            return sizeof(Addon) + neuron_mask.capacity() * sizeof(size_t);
+        }
+
+        // keeps the neuron mask valid when the network renumbers its neurons. new_indices maps the old neuron indices to the new ones
+        virtual void relabel_neurons(const std::vector<size_t>& new_indices) {
+            for (auto& n: neuron_mask) {
+                n = new_indices[n];
+            }
+        }
+        
         template <typename T>
         static void copy_to(char* target, T t) {
             *reinterpret_cast<T*>(target) = t;
@@ -74,9 +101,22 @@ namespace hummus {
         bool no_automatic_include() {
             return do_not_automatically_include;
         }
+
+        bool subscribes_to(addon_hook hook) const {
+            return subscribed_hooks & (1u << static_cast<unsigned>(hook));
+        }
         
     protected:
+        // restricts the per-event messages the addon receives. addons subscribe to every hook by default and should call this in their constructor with the hooks they override
+        void subscribe_to(std::initializer_list<addon_hook> hooks) {
+            subscribed_hooks = 0;
+            for (auto hook: hooks) {
+                subscribed_hooks |= static_cast<std::uint8_t>(1u << static_cast<unsigned>(hook));
+            }
+        }
+
         std::vector<size_t> neuron_mask;
         bool                do_not_automatically_include;
+        std::uint8_t        subscribed_hooks;
 	};
 }
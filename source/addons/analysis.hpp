@@ -30,6 +30,8 @@ namespace hummus {
         Analysis(std::deque<label>& testLabels, std::string _filename="") :
         filename(_filename),
         labels(testLabels) {
+            subscribe_to({addon_hook::neuron_fired});
+
             // save label ids
             std::transform(testLabels.begin(), testLabels.end(),std::back_inserter(actual_labels),[](label& l) {return l.id;});
         }
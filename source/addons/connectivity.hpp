@@ -38,7 +38,7 @@ namespace hummus {
                 auto& neurons = network->get_layers()[network->get_decision_parameters().layer_number-1].neurons;
                 number_of_neurons = static_cast<int>(neurons.size());
                 for (auto& n: neurons) {
-                    output_neurons.emplace_back(static_cast<int>(n));
+                    output_neurons.emplace_back(network->get_user_id(static_cast<int>(n)));
                     
                     if (network->get_neurons()[n]->get_axon_terminals().empty()) {
                         output_neurons.emplace_back(0);
@@ -50,7 +50,7 @@ namespace hummus {
                 auto& neurons = network->get_layers()[network->get_decision_parameters().layer_number-2].neurons;
                 number_of_neurons = static_cast<int>(neurons.size());
                 for (auto& n: neurons) {
-                    output_neurons.emplace_back(static_cast<int>(n));
+                    output_neurons.emplace_back(network->get_user_id(static_cast<int>(n)));
                     if (network->get_neurons()[n]->get_axon_terminals().empty()) {
                         output_neurons.emplace_back(0);
                     } else {
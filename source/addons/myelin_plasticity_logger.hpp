@@ -30,6 +30,7 @@ namespace hummus {
         MyelinPlasticityLogger(std::string filename) :
         save_file(filename, std::ios::out | std::ios::binary),
         previous_timestamp(0) {
+            subscribe_to({});
             
             if (!save_file.good()) {
                 throw std::runtime_error("the file could not be opened");
@@ -56,12 +57,12 @@ namespace hummus {
             std::vector<char> bytes(bitSize);
             copy_to(bytes.data() + 0, static_cast<int16_t>(bitSize));
             copy_to(bytes.data() + 2, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
-            copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+            copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
 
             int count = 8;
             for (int i=0; i<static_cast<int>(timeDifferences.size()); i++) {
                 copy_to(bytes.data() + count,   static_cast<int32_t>(timeDifferences[i] * 100));
-                copy_to(bytes.data() + count+4, static_cast<int16_t>(modifiedSynapses[i]->get_presynaptic_neuron_id()));
+                copy_to(bytes.data() + count+4, static_cast<int16_t>(network->get_user_id(modifiedSynapses[i]->get_presynaptic_neuron_id())));
                 copy_to(bytes.data() + count+6, static_cast<int16_t>(modifiedSynapses[i]->get_delay()*100));
                 copy_to(bytes.data() + count+8, static_cast<int8_t>(modifiedSynapses[i]->get_weight()*100));
                 count += 9;
@@ -33,6 +33,8 @@ namespace hummus {
                 save_file(filename, std::ios::out | std::ios::binary),
                 log_everything(logLearning),
                 previous_timestamp(0) {
+            subscribe_to({addon_hook::incoming_spike, addon_hook::neuron_fired, addon_hook::status_update});
+
             if (!save_file.good()) {
                 throw std::runtime_error("the file could not be opened");
             }
@@ -57,7 +59,7 @@ namespace hummus {
                 std::array<char, 8> bytes;
                 copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                 copy_to(bytes.data() + 4, static_cast<int16_t>(postsynapticNeuron->get_potential() * 100));
-                copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+                copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
                 
                 // saving to file
                 save_file.write(bytes.data(), bytes.size());
@@ -71,7 +73,7 @@ namespace hummus {
                     std::array<char, 8> bytes;
                     copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                     copy_to(bytes.data() + 4, static_cast<int16_t>(network->get_neurons()[s->get_postsynaptic_neuron_id()]->get_potential() * 100));
-                    copy_to(bytes.data() + 6, static_cast<int16_t>(s->get_postsynaptic_neuron_id()));
+                    copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(s->get_postsynaptic_neuron_id())));
                     
                     // saving to file
                     save_file.write(bytes.data(), bytes.size());
@@ -88,7 +90,7 @@ namespace hummus {
                 std::array<char, 8> bytes;
                 copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                 copy_to(bytes.data() + 4, static_cast<int16_t>(postsynapticNeuron->get_potential() * 100));
-                copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+                copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
                 
                 // saving to file
                 save_file.write(bytes.data(), bytes.size());
@@ -102,7 +104,7 @@ namespace hummus {
                     std::array<char, 8> bytes;
                     copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                     copy_to(bytes.data() + 4, static_cast<int16_t>(postsynapticNeuron->get_potential() * 100));
-                    copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+                    copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
                     
                     // saving to file
                     save_file.write(bytes.data(), bytes.size());
@@ -119,7 +121,7 @@ namespace hummus {
                 std::array<char, 8> bytes;
                 copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                 copy_to(bytes.data() + 4, static_cast<int16_t>(postsynapticNeuron->get_potential() * 100));
-                copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+                copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
                 
                 // saving to file
                 save_file.write(bytes.data(), bytes.size());
@@ -133,7 +135,7 @@ namespace hummus {
                     std::array<char, 8> bytes;
                     copy_to(bytes.data() + 0, static_cast<int32_t>((timestamp - previous_timestamp) * 100));
                     copy_to(bytes.data() + 4, static_cast<int16_t>(postsynapticNeuron->get_potential() * 100));
-                    copy_to(bytes.data() + 6, static_cast<int16_t>(postsynapticNeuron->get_neuron_id()));
+                    copy_to(bytes.data() + 6, static_cast<int16_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())));
                     
                     // saving to file
                     save_file.write(bytes.data(), bytes.size());
@@ -35,6 +35,7 @@ namespace hummus {
             save_file(filename, std::ios::out | std::ios::binary),
             step(_step),
             step_couter(1) {
+            subscribe_to({});
                 
             // opening a new binary file to save data in
             if (!save_file.good()) {
@@ -63,7 +64,7 @@ namespace hummus {
                         std::vector<char> bytes(bitSize);
 
                         copy_to(bytes.data() + 0, static_cast<int16_t>(bitSize));
-                        copy_to(bytes.data() + 2, static_cast<int16_t>(n));
+                        copy_to(bytes.data() + 2, static_cast<int16_t>(network->get_user_id(static_cast<int>(n))));
                         copy_to(bytes.data() + 4, static_cast<int8_t>(network->get_classes_map()[network->get_current_label()]));
                         
                         int count = 5;
@@ -86,7 +87,7 @@ namespace hummus {
                 std::vector<char> bytes(bitSize);
 
                 copy_to(bytes.data() + 0, static_cast<int16_t>(bitSize));
-                copy_to(bytes.data() + 2, static_cast<int16_t>(n));
+                copy_to(bytes.data() + 2, static_cast<int16_t>(network->get_user_id(static_cast<int>(n))));
                 copy_to(bytes.data() + 4, static_cast<int8_t>(network->get_classes_map()[network->get_current_label()]));
                 
                 int count = 5;
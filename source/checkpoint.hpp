@@ -0,0 +1,297 @@
+/*
+ * checkpoint.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Versioned binary format used by Network::save_checkpoint and Network::load_checkpoint. A checkpoint is a header followed by a table of named sections, each section starting on an 8-byte boundary so it can be read straight from a memory-mapped file. Neurons and synapses write their parameters and state through a state_archive, which reads the same fields back in the same order. A loader skips the sections it does not know, so new sections can be added without breaking older checkpoints.
+ */
+
+#pragma once
+
+#include <deque>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <filesystem>
+#include <utility>
+#include <stdexcept>
+#include <type_traits>
+
+#include "mapped_file.hpp"
+
+namespace hummus {
+
+    // version written in new checkpoints. loaders refuse checkpoints written by a more recent version
+    inline constexpr std::uint32_t checkpoint_version = 1;
+
+    // saves or loads the fields it is given, in the order it is given them. a serialise method calls archive(a, b, c) and works in both directions
+    class state_archive {
+
+    public:
+
+        // ----- CONSTRUCTORS -----
+        // writes the fields into a buffer
+        state_archive() :
+                loading(false),
+                position(nullptr),
+                end(nullptr) {}
+
+        // reads the fields back from [first, last), usually one section of a mapped checkpoint
+        state_archive(const char* first, const char* last) :
+                loading(true),
+                position(first),
+                end(last) {}
+
+        // ----- PUBLIC METHODS -----
+        template <typename... Ts>
+        void operator()(Ts&... fields) {
+            (field(fields), ...);
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        bool is_loading() const {
+            return loading;
+        }
+
+        // bytes written so far
+        std::vector<char>& get_buffer() {
+            return buffer;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        template <typename T>
+        void field(T& value) {
+            static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable types, strings, pairs, vectors and deques can be archived");
+            bytes(&value, sizeof(T));
+        }
+
+        void field(std::string& value) {
+            std::uint64_t size = value.size();
+            field(size);
+            if (loading) {
+                value.resize(size);
+            }
+            bytes(value.data(), size);
+        }
+
+        template <typename T, typename U>
+        void field(std::pair<T, U>& value) {
+            field(value.first);
+            field(value.second);
+        }
+
+        // trivially copyable elements are copied in one block
+        template <typename T>
+        void field(std::vector<T>& values) {
+            static_assert(!std::is_same_v<T, bool>, "std::vector<bool> cannot be archived");
+            std::uint64_t size = values.size();
+            field(size);
+            if (loading) {
+                values.resize(size);
+            }
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                bytes(values.data(), size * sizeof(T));
+            } else {
+                for (auto& value: values) {
+                    field(value);
+                }
+            }
+        }
+
+        template <typename T>
+        void field(std::deque<T>& values) {
+            std::uint64_t size = values.size();
+            field(size);
+            if (loading) {
+                values.resize(size);
+            }
+            for (auto& value: values) {
+                field(value);
+            }
+        }
+
+        void bytes(void* data, std::size_t size) {
+            if (loading) {
+                if (static_cast<std::size_t>(end - position) < size) {
+                    throw std::logic_error("the checkpoint is truncated or corrupted");
+                }
+                if (size > 0) {
+                    std::memcpy(data, position, size);
+                }
+                position += size;
+            } else {
+                auto first = static_cast<const char*>(data);
+                buffer.insert(buffer.end(), first, first + size);
+            }
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        bool                                      loading;
+        std::vector<char>                         buffer;
+        const char*                               position;
+        const char*                               end;
+    };
+
+    // start of a checkpoint file, followed by the section table
+    struct checkpoint_header {
+        char                          magic[8]; // "HUMMUSCK"
+        std::uint32_t                 version;
+        std::uint32_t                 sections;
+    };
+
+    // entry of the section table
+    struct checkpoint_section {
+        char                          name[16]; // null-terminated
+        std::uint64_t                 offset; // from the start of the file, multiple of 8
+        std::uint64_t                 size;
+    };
+
+    // collects the sections of a checkpoint and writes them in one go
+    class checkpoint_writer {
+
+    public:
+
+        // ----- PUBLIC METHODS -----
+        void add_section(const std::string& name, std::vector<char> data) {
+            if (name.size() >= sizeof(checkpoint_section::name)) {
+                throw std::logic_error("checkpoint section names are limited to 15 characters");
+            }
+            sections.emplace_back(name, std::move(data));
+        }
+
+        // the file is written next to its destination then renamed, so an interrupted save leaves the previous checkpoint intact
+        void save(const std::string& filename) const {
+            auto temporary = filename + ".tmp";
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.good()) {
+                throw std::runtime_error(std::string(filename).append(" could not be opened for writing"));
+            }
+
+            checkpoint_header header{{'H', 'U', 'M', 'M', 'U', 'S', 'C', 'K'}, checkpoint_version, static_cast<std::uint32_t>(sections.size())};
+            std::vector<checkpoint_section> table(sections.size());
+            std::uint64_t offset = align(sizeof(checkpoint_header) + table.size() * sizeof(checkpoint_section));
+            for (std::size_t i=0; i<sections.size(); ++i) {
+                std::memset(table[i].name, 0, sizeof(table[i].name));
+                std::memcpy(table[i].name, sections[i].first.data(), sections[i].first.size());
+                table[i].offset = offset;
+                table[i].size = sections[i].second.size();
+                offset = align(offset + table[i].size);
+            }
+
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(table.data()), static_cast<std::streamsize>(table.size() * sizeof(checkpoint_section)));
+            std::uint64_t written = sizeof(checkpoint_header) + table.size() * sizeof(checkpoint_section);
+            for (std::size_t i=0; i<sections.size(); ++i) {
+                pad(file, table[i].offset - written);
+                file.write(sections[i].second.data(), static_cast<std::streamsize>(table[i].size));
+                written = table[i].offset + table[i].size;
+            }
+
+            file.close();
+            if (!file.good()) {
+                throw std::runtime_error(std::string(filename).append(" could not be written"));
+            }
+            std::filesystem::rename(temporary, filename);
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        static std::uint64_t align(std::uint64_t offset) {
+            return (offset + 7) & ~static_cast<std::uint64_t>(7);
+        }
+
+        static void pad(std::ofstream& file, std::uint64_t bytes) {
+            static const char zeros[8] = {};
+            file.write(zeros, static_cast<std::streamsize>(bytes));
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        std::vector<std::pair<std::string, std::vector<char>>> sections;
+    };
+
+    // read-only view on a checkpoint. the sections are parsed straight from the mapped file
+    class checkpoint_reader {
+
+    public:
+
+        // ----- CONSTRUCTOR -----
+        explicit checkpoint_reader(const std::string& filename) :
+                file(filename),
+                data(file.data()),
+                size(file.size()) {
+
+            // error handling
+            checkpoint_header header;
+            if (size < sizeof(header)) {
+                throw std::logic_error(std::string(filename).append(" is not a hummus checkpoint"));
+            }
+            std::memcpy(&header, data, sizeof(header));
+            if (std::memcmp(header.magic, "HUMMUSCK", sizeof(header.magic)) != 0) {
+                throw std::logic_error(std::string(filename).append(" is not a hummus checkpoint"));
+            }
+
+            if (header.version > checkpoint_version) {
+                throw std::logic_error(std::string(filename).append(" was written by a more recent version of hummus"));
+            }
+
+            version = header.version;
+            if (size < sizeof(header) + header.sections * sizeof(checkpoint_section)) {
+                throw std::logic_error("the checkpoint is truncated or corrupted");
+            }
+            table.resize(header.sections);
+            std::memcpy(table.data(), data + sizeof(header), table.size() * sizeof(checkpoint_section));
+            for (auto& section: table) {
+                section.name[sizeof(section.name) - 1] = '\0';
+                if (section.offset > size || section.size > size - section.offset) {
+                    throw std::logic_error("the checkpoint is truncated or corrupted");
+                }
+            }
+        }
+
+        // ----- PUBLIC METHODS -----
+        bool has_section(const std::string& name) const {
+            return find(name) != nullptr;
+        }
+
+        // archive reading one section. the archive points into the file so it cannot outlive the reader
+        state_archive section(const std::string& name) const {
+            auto entry = find(name);
+            if (!entry) {
+                throw std::logic_error(std::string("the checkpoint has no ").append(name).append(" section"));
+            }
+            return state_archive(data + entry->offset, data + entry->offset + entry->size);
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        std::uint32_t get_version() const {
+            return version;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        const checkpoint_section* find(const std::string& name) const {
+            for (auto& section: table) {
+                if (name == section.name) {
+                    return &section;
+                }
+            }
+            return nullptr;
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        mapped_file                               file;
+        const char*                               data;
+        std::size_t                               size;
+        std::uint32_t                             version;
+        std::vector<checkpoint_section>           table;
+    };
+}
@@ -16,20 +16,31 @@
 #define _USE_MATH_DEFINES
 
 #include <algorithm>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <iostream>
 #include <numeric>
 #include <random>
 #include <utility>
 #include <vector>
+#include <memory>
 #include <chrono>
 #include <thread>
 #include <string>
+#include <sstream>
 #include <cmath>
 #include <mutex>
+#include <new>
 #include <deque>
 #include <queue>
 #include <set>
+#include <array>
+#include <tuple>
+#include <map>
+#include <limits>
+#include <exception>
 
 // external Dependencies
 #include "third_party/sepia.hpp"
@@ -41,6 +52,11 @@
 
 // data parser
 #include "data_parser.hpp"
+#include "memory_policy.hpp"
+#include "philox.hpp"
+#include "checkpoint.hpp"
+#include "es_file.hpp"
+#include "prefetcher.hpp"
 
 // addons
 #include "addon.hpp"
@@ -52,6 +68,10 @@
 #include "synapses/square.hpp"
 #include "synapses/memristor.hpp"
 
+// implicit connections
+#include "projection.hpp"
+#include "inhibition.hpp"
+
 namespace hummus {
 
     enum class optimiser {
@@ -74,6 +94,18 @@ namespace hummus {
         none // synchronous - for updates at every clock (not a real spike)
     };
 
+    // neuron renumbering strategies used by Network::reorder_neurons
+    enum class neuron_ordering {
+        cuthill_mckee, // reverse Cuthill-McKee on the synaptic graph - connected neurons get neighbouring indices
+        spatial_tiling // 2D layers are stored tile by tile instead of row by row
+    };
+
+    // how the layer connection methods keep connection_ratio % of the possible connections
+    enum class connection_sampling {
+        exact, // exactly connection_ratio % of the connections
+        bernoulli // every connection independently, with a probability of connection_ratio %
+    };
+
     // parameters for the decision-making layer
     struct decision_heuristics {
         int                           layer_number; // decision_making layer id
@@ -82,6 +114,225 @@ namespace hummus {
         float                         timer; // selects how often a decision neuron fires. for es files: set to 0 if Decision is to be made at the end of the file
     };
 
+    // number of objects and bytes used by one component of a network
+    struct memory_usage {
+        // bookkeeping paid to the allocator for every separate heap block (glibc malloc header and alignment)
+        static constexpr std::size_t heap_block_overhead = 2 * sizeof(void*);
+
+        std::size_t                   count = 0; // number of objects
+        std::size_t                   bytes = 0; // bytes used by the objects and their containers
+        std::size_t                   heap_blocks = 0; // number of separate heap allocations
+
+        void add(std::size_t _count, std::size_t _bytes, std::size_t _heap_blocks=0) {
+            count += _count;
+            bytes += _bytes;
+            heap_blocks += _heap_blocks;
+        }
+
+        // bytes including the estimated allocator overhead
+        std::size_t total() const {
+            return bytes + heap_blocks * heap_block_overhead;
+        }
+    };
+
+    // per-component breakdown of the memory used by a network (see Network::memory_footprint)
+    struct memory_report {
+        memory_usage                           neurons; // neuron objects, including the unused capacity of the pools
+        memory_usage                           neuron_containers; // dendritic trees, axon terminals and addon lists owned by the neurons
+        std::map<std::string, memory_usage>    synapses; // synapse objects by synapse model
+        memory_usage                           synapse_pools; // chunks of the synapse arenas not taken by the synapse objects: headers, padding, freed and unused space
+        memory_usage                           spike_queue;
+        memory_usage                           predicted_spikes;
+        memory_usage                           layers; // layer, sublayer and receptive field structures
+        memory_usage                           addons;
+        memory_usage                           projections; // kernels and ports of the implicit projections, cells of the implicit lateral inhibitions
+        memory_usage                           random_engines;
+        memory_usage                           bookkeeping; // neuron handles, decision history, labels and id mappings
+
+        memory_usage total() const {
+            memory_usage sum;
+            for (auto* usage: {&neurons, &neuron_containers, &synapse_pools, &spike_queue, &predicted_spikes, &layers, &addons, &projections, &random_engines, &bookkeeping}) {
+                sum.add(usage->count, usage->bytes, usage->heap_blocks);
+            }
+            for (auto& synapse_model: synapses) {
+                sum.add(synapse_model.second.count, synapse_model.second.bytes, synapse_model.second.heap_blocks);
+            }
+            return sum;
+        }
+
+        // human-readable summary in megabytes
+        void print(std::ostream& stream=std::cout) const {
+            auto line = [&](const std::string& name, const memory_usage& usage) {
+                stream << name << ": " << usage.count << " objects, " << static_cast<double>(usage.total()) / (1024 * 1024) << " MB" << std::endl;
+            };
+            line("neurons", neurons);
+            line("neuron containers", neuron_containers);
+            for (auto& synapse_model: synapses) {
+                line(synapse_model.first + " synapses", synapse_model.second);
+            }
+            line("synapse pools", synapse_pools);
+            line("spike queue", spike_queue);
+            line("predicted spikes", predicted_spikes);
+            line("layers", layers);
+            line("addons", addons);
+            line("projections", projections);
+            line("random engines", random_engines);
+            line("bookkeeping", bookkeeping);
+            line("total", total());
+        }
+    };
+
+    // spike-label history of the neurons feeding the decision-making layer. each neuron gets a fixed-capacity ring buffer of spike_history_size labels inside one flat array, and no other neuron pays for it
+    class decision_history {
+
+    public:
+
+        // view on the labels recorded for one neuron (in no particular order)
+        struct labels {
+            const int*  first;
+            const int*  last;
+
+            const int* begin() const {
+                return first;
+            }
+
+            const int* end() const {
+                return last;
+            }
+
+            std::size_t size() const {
+                return static_cast<std::size_t>(last - first);
+            }
+
+            bool empty() const {
+                return first == last;
+            }
+        };
+
+        // ----- CONSTRUCTOR -----
+        decision_history() :
+                first_neuron(0),
+                capacity(0) {}
+
+        // ----- PUBLIC METHODS -----
+        // reserves one ring buffer per neuron of the contiguous range [_first_neuron, _first_neuron + number_of_neurons)
+        void allocate(std::size_t _first_neuron, std::size_t number_of_neurons, int _capacity) {
+            first_neuron = _first_neuron;
+            capacity = static_cast<std::size_t>(std::max(_capacity, 0));
+            buffer.assign(number_of_neurons * capacity, 0);
+            heads.assign(number_of_neurons, 0);
+            counts.assign(number_of_neurons, 0);
+        }
+
+        // saves the label of a spike, overwriting the oldest one when the ring buffer is full
+        void record(std::size_t neuron_idx, int label) {
+            if (!contains(neuron_idx) || capacity == 0) {
+                return;
+            }
+
+            auto local = neuron_idx - first_neuron;
+            auto* ring = buffer.data() + local * capacity;
+            if (counts[local] < capacity) {
+                ring[counts[local]] = label;
+                ++counts[local];
+            } else {
+                ring[heads[local]] = label;
+                heads[local] = (heads[local] + 1) % capacity;
+            }
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        bool contains(std::size_t neuron_idx) const {
+            return neuron_idx >= first_neuron && neuron_idx - first_neuron < counts.size();
+        }
+
+        labels get_labels(std::size_t neuron_idx) const {
+            if (!contains(neuron_idx)) {
+                return labels{nullptr, nullptr};
+            }
+            auto local = neuron_idx - first_neuron;
+            const int* ring = buffer.data() + local * capacity;
+            return labels{ring, ring + counts[local]};
+        }
+
+        std::size_t get_memory_footprint() const {
+            return buffer.capacity() * sizeof(int) + (heads.capacity() + counts.capacity()) * sizeof(std::size_t);
+        }
+
+        // saves or loads the ring buffers (see Network::save_checkpoint)
+        void serialise(state_archive& archive) {
+            archive(buffer, heads, counts, first_neuron, capacity);
+        }
+
+    protected:
+        std::vector<int>              buffer;
+        std::vector<std::size_t>      heads;
+        std::vector<std::size_t>      counts;
+        std::size_t                   first_neuron;
+        std::size_t                   capacity;
+    };
+
+    // contiguous range of neuron indices [first, last). layers and sublayers always own a contiguous block of the neurons vector so membership doesn't need an explicit list
+    struct neuron_range {
+
+        // iterates over the indices of the range by value
+        class iterator {
+
+        public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type        = std::size_t;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const std::size_t*;
+            using reference         = const std::size_t&;
+
+            iterator() : idx(0) {}
+            explicit iterator(std::size_t _idx) : idx(_idx) {}
+
+            reference operator*() const { return idx; }
+            pointer operator->() const { return &idx; }
+            value_type operator[](difference_type n) const { return idx + n; }
+
+            iterator& operator++() { ++idx; return *this; }
+            iterator operator++(int) { iterator previous = *this; ++idx; return previous; }
+            iterator& operator--() { --idx; return *this; }
+            iterator operator--(int) { iterator previous = *this; --idx; return previous; }
+            iterator& operator+=(difference_type n) { idx += n; return *this; }
+            iterator& operator-=(difference_type n) { idx -= n; return *this; }
+            iterator operator+(difference_type n) const { return iterator(idx + n); }
+            friend iterator operator+(difference_type n, const iterator& it) { return iterator(it.idx + n); }
+            iterator operator-(difference_type n) const { return iterator(idx - n); }
+            difference_type operator-(const iterator& other) const { return static_cast<difference_type>(idx) - static_cast<difference_type>(other.idx); }
+
+            bool operator==(const iterator& other) const { return idx == other.idx; }
+            bool operator!=(const iterator& other) const { return idx != other.idx; }
+            bool operator<(const iterator& other) const { return idx < other.idx; }
+            bool operator>(const iterator& other) const { return idx > other.idx; }
+            bool operator<=(const iterator& other) const { return idx <= other.idx; }
+            bool operator>=(const iterator& other) const { return idx >= other.idx; }
+
+        private:
+            std::size_t idx;
+        };
+
+        iterator begin() const { return iterator(first); }
+        iterator end() const { return iterator(last); }
+
+        std::size_t size() const { return last - first; }
+        bool empty() const { return first == last; }
+
+        std::size_t operator[](std::size_t i) const { return first + i; }
+        std::size_t front() const { return first; }
+        std::size_t back() const { return last - 1; }
+
+        bool contains(std::size_t idx) const { return idx >= first && idx < last; }
+
+        // explicit list of the indices, so a range can be given to the methods taking one such as Addon::activate_for
+        operator std::vector<std::size_t>() const { return std::vector<std::size_t>(begin(), end()); }
+
+        std::size_t                   first = 0;
+        std::size_t                   last = 0;
+    };
+
     // receptive_field
     struct receptive_field {
         std::vector<std::size_t>      neurons; // neuron indices belonging to the receptive field
@@ -91,14 +342,14 @@ namespace hummus {
     // the equivalent of feature maps
 	struct sublayer {
         std::vector<receptive_field>  receptive_fields; // receptive fields of a sublayer
-		std::vector<std::size_t>      neurons; // neuron indices belonging to a sublayer
+		neuron_range                  neurons; // neuron indices belonging to a sublayer
 		int                           id; // sublayer ID
 	};
 
     // structure organising neurons into layers and sublayers for easier access
 	struct layer {
 		std::vector<sublayer>         sublayers; // sublayers belonging to layer
-        std::vector<std::size_t>      neurons; // neuron indices belonging to layer
+        neuron_range                  neurons; // neuron indices belonging to layer
 		int                           id; // layer ID
         bool                          active = true; // whether or not a layer receives spikes
 		int                           width = -1; // width of the layer (if make_grid is used)
@@ -112,6 +363,7 @@ namespace hummus {
         double        timestamp; // timestamp of the spike (arbitrary unit but make sure to stay consistent with all the other parameters)
         Synapse*      propagation_synapse; // which synapse is propagating a spike - for access to pre and post-synaptic neurons to know where to send the spike
         spike_type    type; // type of spike (to differentiate between real spikes and other spikes used by the network)
+        int           source = -1; // presynaptic neuron of a spike sent through a projection port
 
         // provides the logic for the priority queue
         bool operator<(const spike& s) const {
@@ -119,9 +371,179 @@ namespace hummus {
         }
     };
 
+    // connection recorded by the layer connection methods before the synapses are created
+    struct planned_connection {
+        std::size_t                   pre; // presynaptic neuron index
+        std::size_t                   post; // postsynaptic neuron index
+        int                           x; // coordinates and depth handed to the weight and delay distribution
+        int                           y;
+        int                           depth;
+        std::uint32_t                 synapse; // index of the synapse between pre and post (arborescence)
+        bool                          forward = true; // creates pre -> post
+        bool                          backward = false; // creates post -> pre with the same weight and delay
+    };
+
+    // streaming selection of the connections kept by a layer connection method. the connections are queried in increasing order, which lets the sampler decide on the fly instead of shuffling a table of every possible connection
+    class connection_sampler {
+
+    public:
+        // ----- CONSTRUCTOR -----
+        connection_sampler(connection_sampling _mode, int connection_ratio, std::size_t _candidates, philox_engine _engine) :
+                mode(_mode),
+                candidates(_candidates),
+                remaining(std::min(_candidates, static_cast<std::size_t>(std::max(connection_ratio, 0)) * _candidates / 100)),
+                selections(remaining),
+                probability(std::min(std::max(connection_ratio, 0), 100) / 100.),
+                position(0),
+                next(0),
+                last_selected(false),
+                engine(_engine) {
+
+            // geometric skips to the first connection
+            if (mode == connection_sampling::bernoulli && probability < 1) {
+                next = probability > 0 ? skip() : candidates;
+            }
+        }
+
+        // ----- PUBLIC METHODS -----
+        // whether the connection idx is kept. idx can repeat but never decrease between calls
+        bool selected(std::size_t idx) {
+            if (mode == connection_sampling::bernoulli) {
+                if (probability >= 1) {
+                    return true;
+                }
+
+                // each connection is kept independently, so the sampler jumps from one kept connection to the next
+                while (next < idx) {
+                    next += 1 + skip();
+                }
+                return next == idx;
+            }
+
+            // selection sampling (Knuth, TAOCP vol. 2, algorithm S): every connection is kept with a probability of the number of connections left to choose over the number of connections left to see, which keeps exactly the requested count
+            while (position <= idx) {
+                last_selected = static_cast<double>(candidates - position) * uniform() < static_cast<double>(remaining);
+                if (last_selected) {
+                    --remaining;
+                }
+                ++position;
+            }
+            return last_selected;
+        }
+
+        // first connection kept from idx onwards, or the number of connections if there are none left. lets sparse projections skip the rejected connections
+        std::size_t next_selected(std::size_t idx) {
+            if (mode == connection_sampling::bernoulli) {
+                if (probability >= 1) {
+                    return std::min(idx, candidates);
+                }
+
+                while (next < idx) {
+                    next += 1 + skip();
+                }
+                return std::min(next, candidates);
+            }
+
+            while (idx < candidates && !selected(idx)) {
+                ++idx;
+            }
+            return idx;
+        }
+
+        // number of connections kept over the whole range: exact in the exact mode, the mean in the bernoulli mode. lets the builders reserve their plan without a slot for every candidate
+        std::size_t expected_selections() const {
+            if (mode == connection_sampling::bernoulli) {
+                return probability >= 1 ? candidates : static_cast<std::size_t>(std::ceil(probability * static_cast<double>(candidates)));
+            }
+            return selections;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        // uniform in [0, 1) with 53 bits
+        double uniform() {
+            std::uint64_t high = engine() >> 5;
+            std::uint64_t low = engine() >> 6;
+            return static_cast<double>((high << 26) | low) * (1. / 9007199254740992.);
+        }
+
+        // number of connections rejected before the next kept one
+        std::size_t skip() {
+            double gap = std::floor(std::log(1 - uniform()) / std::log(1 - probability));
+            return gap < static_cast<double>(candidates) ? static_cast<std::size_t>(gap) : candidates;
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        connection_sampling                       mode;
+        std::size_t                               candidates;
+        std::size_t                               remaining; // connections still to keep in the exact mode
+        std::size_t                               selections; // connections kept in the exact mode
+        double                                    probability;
+        std::size_t                               position; // connections seen in the exact mode
+        std::size_t                               next; // next connection kept in the bernoulli mode
+        bool                                      last_selected;
+        philox_engine                             engine;
+    };
+
     // forward declaration of the Network class
 	class Network;
 
+    // addons of a neuron grouped by the hooks they subscribed to, in one vector ordered by hook so a neuron only pays for one allocation
+    class hook_subscribers {
+
+    public:
+
+        // view on the addons subscribed to one hook
+        struct addons {
+            Addon* const*  first;
+            Addon* const*  last;
+
+            Addon* const* begin() const {
+                return first;
+            }
+
+            Addon* const* end() const {
+                return last;
+            }
+
+            bool empty() const {
+                return first == last;
+            }
+        };
+
+        // ----- PUBLIC METHODS -----
+        void add(Addon* addon) {
+            for (std::size_t hook=0; hook<number_of_addon_hooks; ++hook) {
+                if (addon->subscribes_to(static_cast<addon_hook>(hook))) {
+                    subscribers.insert(subscribers.begin() + offsets[hook+1], addon);
+                    for (auto next=hook+1; next<offsets.size(); ++next) {
+                        ++offsets[next];
+                    }
+                }
+            }
+        }
+
+        void clear() {
+            subscribers.clear();
+            offsets.fill(0);
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        addons get(addon_hook hook) const {
+            auto h = static_cast<std::size_t>(hook);
+            return addons{subscribers.data() + offsets[h], subscribers.data() + offsets[h+1]};
+        }
+
+        std::size_t get_memory_footprint() const {
+            return subscribers.capacity() * sizeof(Addon*);
+        }
+
+    protected:
+        std::vector<Addon*>                                  subscribers;
+        std::array<std::uint32_t, number_of_addon_hooks+1>  offsets{};
+    };
+
     // polymorphic neuron class - the different implementations extending this class are available in the neurons folder
 	class Neuron {
 
@@ -147,13 +569,19 @@ namespace hummus {
                 active(true),
                 previous_spike_time(0),
                 previous_input_time(0),
-                class_label(_classLabel) {
+                class_label(_classLabel),
+                lateral_inhibition(nullptr),
+                synapse_memory(nullptr),
+                reset_epoch(0) {
             // error handling
             if (membrane_time_constant <= 0) {
                 throw std::logic_error("The potential decay cannot less than or equal to 0");
             }
         }
 
+        // neurons are moved in memory when the network reorders them
+        Neuron(Neuron&&) = default;
+
 		virtual ~Neuron(){}
 
 		// ----- PUBLIC METHODS -----
@@ -162,6 +590,14 @@ namespace hummus {
 
         // ability to do things inside a neuron, after the network is done running
         virtual void end(Network* network) {}
+
+        // ability to forget the synapses a neuron keeps between updates, after Network::prune_synapses removed some of its dendrites
+        virtual void synapses_pruned() {}
+
+        // whether the model reads the current of an implicit lateral inhibition. the other models cannot be given one
+        virtual bool integrates_lateral_inhibition() const {
+            return false;
+        }
         
 		// asynchronous update method
 		virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) = 0;
@@ -171,7 +607,7 @@ namespace hummus {
 			update(timestamp, s, network, timestep, type);
 		}
 
-        // reset a neuron to its initial status
+        // reset a neuron to its initial status. every synapse belongs to the dendritic tree of its postsynaptic neuron, so the axon terminals are reset by the neurons they reach
         virtual void reset_neuron(Network* network, bool clearAddons=true) {
             active = true;
             previous_input_time = 0;
@@ -183,21 +619,25 @@ namespace hummus {
                 dendrite->reset();
             }
 
-            for (auto& axon_terminal: axon_terminals) {
-                axon_terminal->reset();
-            }
-
             if (clearAddons) {
-                relevant_addons.clear();
+                clear_relevant_addons();
             }
         }
 
         // adds a synapse that connects two Neurons together
         template <typename T = Synapse, typename... Args>
         Synapse* make_synapse(Neuron* post_neuron, float weight, float delay, Args&&... args) {
+            Synapse* synapse = make_axon_terminal<T>(post_neuron, weight, delay, std::forward<Args>(args)...);
+            post_neuron->get_dendritic_tree().emplace_back(synapse);
+            return synapse;
+        }
+
+        // first half of make_synapse: only touches this neuron, so neurons can build their axon terminals in parallel. the synapse still has to be added to the dendritic tree of post_neuron
+        template <typename T = Synapse, typename... Args>
+        Synapse* make_axon_terminal(Neuron* post_neuron, float weight, float delay, Args&&... args) {
             if (post_neuron) {
-                axon_terminals.emplace_back(new T{post_neuron->neuron_id, neuron_id, weight, delay, static_cast<float>(std::forward<Args>(args))...});
-                post_neuron->get_dendritic_tree().emplace_back(axon_terminals.back().get());
+                axon_terminals.emplace_back(new (synapse_memory) T{post_neuron->neuron_id, neuron_id, weight, delay, static_cast<float>(std::forward<Args>(args))...});
+                axon_terminals.back()->set_postsynaptic_layer_id(post_neuron->get_layer_id());
                 return axon_terminals.back().get();
             } else {
                 throw std::logic_error("Neuron does not exist");
@@ -208,7 +648,7 @@ namespace hummus {
         template <typename T = Synapse, typename... Args>
         spike receive_external_input(double timestamp, spike_type type, Args&&... args) {
             if (!initial_synapse) {
-                initial_synapse.reset(new T(std::forward<Args>(args)...));
+                initial_synapse.reset(new (synapse_memory) T(std::forward<Args>(args)...));
             }
             return spike{timestamp, initial_synapse.get(), type};
         }
@@ -216,6 +656,25 @@ namespace hummus {
         // share information - generic getter that can be used for accessing child members from parent
         virtual float share_information() { return 0; }
 
+        // records that the state of the neuron changed during the presentation numbered epoch. true only the first time, so the network lists each neuron once per presentation (see Network::touch_neuron)
+        bool mark_for_reset(std::uint32_t epoch) {
+            if (reset_epoch == epoch) {
+                return false;
+            }
+            reset_epoch = epoch;
+            return true;
+        }
+
+        // saves or loads the parameters and state of the neuron (see Network::save_checkpoint). neuron models extend it with their own members and give themselves a model_name
+        virtual void serialise(state_archive& archive) {
+            archive(neuron_id, layer_id, sublayer_id, rf_id, xy_coordinates, current, potential, trace, threshold, resting_potential, trace_time_constant, capacitance, leakage_conductance, membrane_time_constant, refractory_period, active, previous_spike_time, previous_input_time, class_label);
+        }
+
+        // name identifying the neuron model in a checkpoint. models that keep the one of the base class cannot be saved
+        static std::string model_name() {
+            return "Neuron";
+        }
+
 		// ----- SETTERS AND GETTERS -----
         bool get_activity() const {
             return active;
@@ -229,6 +688,10 @@ namespace hummus {
             return neuron_id;
         }
 
+        void set_neuron_id(int new_id) {
+            neuron_id = new_id;
+        }
+
         int get_layer_id() const {
             return layer_id;
         }
@@ -266,6 +729,14 @@ namespace hummus {
             return initial_synapse;
         }
 
+        synapse_arena* get_synapse_arena() const {
+            return synapse_memory;
+        }
+
+        void set_synapse_arena(synapse_arena* arena) {
+            synapse_memory = arena;
+        }
+
         float set_potential(float new_potential) {
             return potential = new_potential;
         }
@@ -327,6 +798,21 @@ namespace hummus {
 
         void add_relevant_addon(Addon* new_addon) {
             relevant_addons.emplace_back(new_addon);
+            hooked_addons.add(new_addon);
+        }
+
+        void clear_relevant_addons() {
+            relevant_addons.clear();
+            hooked_addons.clear();
+        }
+
+        // relevant addons that subscribed to a per-event hook
+        hook_subscribers::addons get_addons_for(addon_hook hook) const {
+            return hooked_addons.get(hook);
+        }
+
+        const hook_subscribers& get_hooked_addons() const {
+            return hooked_addons;
         }
 
         float get_capacitance() const {
@@ -353,10 +839,6 @@ namespace hummus {
             refractory_period = new_refractory_period;
         }
 
-        std::deque<int>& get_decision_queue() {
-            return decision_queue;
-        }
-
         int get_class_label() const {
             return class_label;
         }
@@ -365,8 +847,28 @@ namespace hummus {
             class_label = new_label;
         }
 
+        LateralInhibition* get_lateral_inhibition() const {
+            return lateral_inhibition;
+        }
+
+        void set_lateral_inhibition(LateralInhibition* inhibition) {
+            lateral_inhibition = inhibition;
+        }
+
     protected:
 
+        // current from the implicit lateral inhibition of the layer, 0 if there is none
+        float lateral_inhibition_current(double timestamp) {
+            return lateral_inhibition ? lateral_inhibition->current(neuron_id, timestamp, active) : 0;
+        }
+
+        // clears the implicit lateral inhibition along with the synaptic currents when the neuron fires
+        void reset_lateral_inhibition(double timestamp) {
+            if (lateral_inhibition) {
+                lateral_inhibition->reset_neuron(neuron_id, timestamp);
+            }
+        }
+
         // loops through any learning rules and activates them
         virtual void request_learning(double timestamp, Synapse* s, Neuron* postsynaptic_neuron, Network* network){}
 
@@ -402,10 +904,177 @@ namespace hummus {
         // ----- IMPLEMENTATION PARAMETERS -----
         bool                                      active;
         std::vector<Addon*>                       relevant_addons;
+        hook_subscribers                          hooked_addons;
         double                                    previous_spike_time;
         double                                    previous_input_time;
-        std::deque<int>                           decision_queue;
         int                                       class_label;
+        LateralInhibition*                        lateral_inhibition; // owned by the network
+        synapse_arena*                            synapse_memory; // where the synapses of the neuron are allocated, owned by its neuron pool
+        std::uint32_t                             reset_epoch; // last presentation during which the state of the neuron changed
+    };
+
+    // non-owning view on a neuron stored inside a neuron_pool. keeps the unique_ptr-like interface (->, *, get()) used throughout the code
+    class neuron_handle {
+
+    public:
+
+        // ----- CONSTRUCTOR -----
+        neuron_handle(Neuron* _neuron=nullptr) :
+                neuron(_neuron) {}
+
+        // ----- SETTERS AND GETTERS -----
+        Neuron* get() const {
+            return neuron;
+        }
+
+        Neuron* operator->() const {
+            return neuron;
+        }
+
+        Neuron& operator*() const {
+            return *neuron;
+        }
+
+        explicit operator bool() const {
+            return neuron != nullptr;
+        }
+
+    protected:
+        Neuron*                                   neuron;
+    };
+
+    // polymorphic owner of the neurons created by one layer creation method
+    class neuron_pool {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        neuron_pool() = default;
+        neuron_pool(const neuron_pool&) = delete;
+        neuron_pool& operator=(const neuron_pool&) = delete;
+        virtual ~neuron_pool(){}
+
+        // ----- PUBLIC METHODS -----
+        // moves the neurons so that slot i holds the neuron previously stored in slot order[i]
+        virtual void permute(const std::vector<std::size_t>& order) = 0;
+
+        // whether the neuron type can be moved in memory, which permute needs
+        virtual bool can_permute() const = 0;
+
+        // ----- SETTERS AND GETTERS -----
+        virtual std::size_t size() const = 0;
+
+        virtual Neuron* at(std::size_t i) = 0;
+
+        // bytes reserved for the neuron objects, including unused capacity
+        virtual std::size_t get_memory_footprint() const = 0;
+
+        // model name of the neurons, written in checkpoints
+        virtual std::string get_model_name() const = 0;
+
+        // false when the storage was mapped directly from the kernel and has no allocator overhead
+        virtual bool is_heap_allocated() const = 0;
+
+        // arena the synapses of the neurons in the pool are allocated from
+        virtual const synapse_arena& get_synapse_arena() const = 0;
+    };
+
+    // stores the neurons of a layer contiguously as objects of their concrete type, so iterating over a layer streams through memory
+    template <typename T>
+    class typed_neuron_pool : public neuron_pool {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        explicit typed_neuron_pool(std::size_t _capacity, memory_policy _policy={}) :
+                memory(sizeof(T) * _capacity, alignof(T), _policy),
+                storage(static_cast<T*>(memory.get())),
+                capacity(_capacity),
+                count(0),
+                policy(_policy),
+                synapses(_policy) {}
+
+        virtual ~typed_neuron_pool() {
+            synapses.close();
+            for (std::size_t i=0; i<count; ++i) {
+                storage[i].~T();
+            }
+        }
+
+        // ----- PUBLIC METHODS -----
+        // constructs a neuron in the next free slot of the pool
+        template <typename... Args>
+        T* emplace(Args&&... args) {
+            if (count == capacity) {
+                throw std::logic_error("the neuron pool is full");
+            }
+            T* neuron = new (storage + count) T(std::forward<Args>(args)...);
+            neuron->set_synapse_arena(&synapses);
+            ++count;
+            return neuron;
+        }
+
+        virtual void permute(const std::vector<std::size_t>& order) override {
+            if constexpr (std::is_move_constructible_v<T>) {
+                if (order.size() != count) {
+                    throw std::logic_error("the permutation does not match the number of neurons in the pool");
+                }
+
+                memory_block permuted_memory(sizeof(T) * capacity, alignof(T), policy);
+                T* permuted = static_cast<T*>(permuted_memory.get());
+                for (std::size_t i=0; i<count; ++i) {
+                    new (permuted + i) T(std::move(storage[order[i]]));
+                }
+                for (std::size_t i=0; i<count; ++i) {
+                    storage[i].~T();
+                }
+                memory = std::move(permuted_memory);
+                storage = permuted;
+            } else {
+                throw std::logic_error("this neuron type cannot be moved in memory so its layer cannot be reordered");
+            }
+        }
+
+        virtual bool can_permute() const override {
+            return std::is_move_constructible_v<T>;
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        virtual std::size_t size() const override {
+            return count;
+        }
+
+        virtual Neuron* at(std::size_t i) override {
+            return storage + i;
+        }
+
+        virtual std::size_t get_memory_footprint() const override {
+            return memory.size();
+        }
+
+        virtual bool is_heap_allocated() const override {
+            return !memory.is_mapped();
+        }
+
+        virtual std::string get_model_name() const override {
+            return T::model_name();
+        }
+
+        virtual const synapse_arena& get_synapse_arena() const override {
+            return synapses;
+        }
+
+        T* data() {
+            return storage;
+        }
+
+    protected:
+        memory_block                              memory;
+        T*                                        storage;
+        std::size_t                               capacity;
+        std::size_t                               count;
+        memory_policy                             policy;
+        synapse_arena                             synapses;
     };
 
     class Network {
@@ -423,7 +1092,20 @@ namespace hummus {
                 decision_pre_ts(0),
                 skip_presentation(std::numeric_limits<double>::max()),
                 logistic_regression(false),
-                presentation_counter(0) {
+                presentation_counter(0),
+                seeded_construction(false),
+                construction_seed(0),
+                construction_threads(0),
+                construction_calls(0),
+                projection_key(0),
+                selection_draws(0),
+                sampling(connection_sampling::exact),
+                checkpoint_interval(0),
+                training_position(0),
+                presentation_epoch(1),
+                full_reset_pending(true),
+                prefetch_depth(4),
+                prefetch_threads(1) {
                     std::random_device device;
                     if (seed_network) {
                         std::seed_seq seed{device(), device(), device(), device(), device(), device(), device(), device()};
@@ -433,6 +1115,8 @@ namespace hummus {
                     }
                 }
 
+        virtual ~Network(){}
+
 		// ----- NEURON CREATION METHODS -----
 
         // adds one dimensional neurons
@@ -443,34 +1127,30 @@ namespace hummus {
                 throw std::logic_error("the number of neurons selected is wrong");
             }
 
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
 
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-
-                for (auto& l: layers) {
-                    shift += l.neurons.size();
-                }
-
                 layer_id = layers.back().id+1;
             }
 
             // building a layer of one dimensional sublayers
-            std::vector<std::size_t> neuronsInLayer;
+            auto& pool = make_neuron_pool<T>(_numberOfNeurons);
+            std::size_t first_neuron = neurons.size();
             for (int k=0+shift; k<_numberOfNeurons+shift; k++) {
-                neurons.emplace_back(std::make_unique<T>(k, layer_id, 0, 0, std::pair(-1, -1), std::forward<Args>(args)...));
-
-                neuronsInLayer.emplace_back(neurons.size()-1);
+                neurons.emplace_back(pool.emplace(k, layer_id, 0, 0, std::pair(-1, -1), std::forward<Args>(args)...));
             }
 
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
             }
 
             // building layer structure
-            layers.emplace_back(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id});
+            add_layer(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id});
             return layers.back();
         }
 
@@ -495,21 +1175,18 @@ namespace hummus {
                 classes_map[label.second] = 0;
             }
             
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
             
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-                for (auto& l: layers) {
-                    shift += static_cast<int>(l.neurons.size());
-                }
                 layer_id = layers.back().id+1;
             } else {
                 throw std::logic_error("the regression layer can only be on the last layer");
             }
             
             // create the computation layer of regression neuron
-            neurons.emplace_back(std::make_unique<T>(shift, layer_id, 0, 0, std::pair(-1, -1), -1, learning_rate, momentum, weight_decay, lr_decay, epochs, batch_size, log_interval, presentations_before_training, opt, save_tensor, std::forward<Args>(args)...));
+            neurons.emplace_back(make_neuron_pool<T>(1).emplace(shift, layer_id, 0, 0, std::pair(-1, -1), -1, learning_rate, momentum, weight_decay, lr_decay, epochs, batch_size, log_interval, presentations_before_training, opt, save_tensor, std::forward<Args>(args)...));
             
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
@@ -517,18 +1194,20 @@ namespace hummus {
             }
             
             // building computation layer structure
-            layers.emplace_back(layer{{sublayer{{}, {neurons.size()-1}, 0}}, {neurons.size()-1}, layer_id});
+            add_layer(layer{{sublayer{{}, neuron_range{neurons.size()-1, neurons.size()}, 0}}, neuron_range{neurons.size()-1, neurons.size()}, layer_id});
             
             // create the decision layer of regression neurons
-            std::vector<std::size_t> neuronsInLayer;
+            auto& pool = make_neuron_pool<T>(training_dataset.class_map.size());
+            std::size_t first_neuron = neurons.size();
 
             int i=1;
             for (const auto& label: training_dataset.class_map) {
-                neurons.emplace_back(std::make_unique<T>(i+shift, layer_id+1, 0, 0, std::pair(-1, -1), label.second, learning_rate, momentum, weight_decay, lr_decay, epochs, batch_size, log_interval, presentations_before_training, opt, save_tensor, std::forward<Args>(args)...));
-                neuronsInLayer.emplace_back(neurons.size()-1);
+                neurons.emplace_back(pool.emplace(i+shift, layer_id+1, 0, 0, std::pair(-1, -1), label.second, learning_rate, momentum, weight_decay, lr_decay, epochs, batch_size, log_interval, presentations_before_training, opt, save_tensor, std::forward<Args>(args)...));
                 ++i;
             }
             
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
@@ -539,7 +1218,7 @@ namespace hummus {
             decision.timer = _timer;
             
             // building decision layer structure
-            layers.emplace_back(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id+1, false});
+            add_layer(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id+1, false});
 
             // connecting the computation layer with the previous layer all_to_all
             all_to_all<>(layers[layer_id-1], layers[layer_id], 1, hummus::Normal(1), 100);
@@ -572,29 +1251,28 @@ namespace hummus {
                 classes_map[label.second] = 0;
             }
             
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
 
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-                for (auto& l: layers) {
-                    shift += static_cast<int>(l.neurons.size());
-                }
                 layer_id = layers.back().id+1;
             } else {
                 throw std::logic_error("the decision layer can only be on the last layer");
             }
 
             // add decision-making neurons
-            std::vector<std::size_t> neuronsInLayer;
+            auto& pool = make_neuron_pool<T>(training_dataset.class_map.size());
+            std::size_t first_neuron = neurons.size();
 
             int i=0;
             for (const auto& label: training_dataset.class_map) {
-                neurons.emplace_back(std::make_unique<T>(i+shift, layer_id, 0, 0, std::pair(-1, -1), label.second, std::forward<Args>(args)...));
-                neuronsInLayer.emplace_back(neurons.size()-1);
+                neurons.emplace_back(pool.emplace(i+shift, layer_id, 0, 0, std::pair(-1, -1), label.second, std::forward<Args>(args)...));
                 ++i;
             }
 
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
@@ -606,8 +1284,12 @@ namespace hummus {
             decision.rejection_threshold = _rejection_threshold;
             decision.timer = _timer;
             
+            // only the neurons of the previous layer keep a spike-label history
+            auto& pre_decision_layer = layers.back();
+            decision_labels.allocate(pre_decision_layer.neurons.front(), pre_decision_layer.neurons.size(), _spike_history_size);
+            
             // building layer structure
-            layers.emplace_back(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id, false});
+            add_layer(layer{{sublayer{{}, neuronsInLayer, 0}}, neuronsInLayer, layer_id, false});
 
             return layers.back();
         }
@@ -615,45 +1297,43 @@ namespace hummus {
         // adds neurons arranged in circles of various radii
         template <typename T, typename... Args>
         layer make_circle(int _numberOfNeurons, std::vector<float> _radii, std::vector<Addon*> _addons, Args&&... args) {
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
 
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-                for (auto& l: layers) {
-                    shift += l.neurons.size();
-                }
                 layer_id = layers.back().id+1;
             }
 
             // building a layer of two dimensional sublayers
             int counter = 0;
+            auto& pool = make_neuron_pool<T>(_numberOfNeurons * _radii.size());
             std::vector<sublayer> sublayers;
-            std::vector<std::size_t> neuronsInLayer;
+            std::size_t first_neuron = neurons.size();
             float inv_number_neurons = 1. / _numberOfNeurons;
             for (int i=0; i<static_cast<int>(_radii.size()); i++) {
-                std::vector<std::size_t> neuronsInSublayer;
+                std::size_t first_sublayer_neuron = neurons.size();
                 for (int k=0+shift; k<_numberOfNeurons+shift; k++) {
                     // we round the coordinates because the precision isn't needed and xy_coordinates are int
                     int u = static_cast<int>(std::round(_radii[i] * std::cos(2*M_PI*(k-shift) * inv_number_neurons)));
                     int v = static_cast<int>(std::round(_radii[i] * std::sin(2*M_PI*(k-shift) * inv_number_neurons)));
-                    neurons.emplace_back(std::make_unique<T>(k+counter, layer_id, i, 0, std::pair(u, v), std::forward<Args>(args)...));
-                    neuronsInSublayer.emplace_back(neurons.size()-1);
-                    neuronsInLayer.emplace_back(neurons.size()-1);
+                    neurons.emplace_back(pool.emplace(k+counter, layer_id, i, 0, std::pair(u, v), std::forward<Args>(args)...));
                 }
-                sublayers.emplace_back(sublayer{{}, neuronsInSublayer, i});
+                sublayers.emplace_back(sublayer{{}, neuron_range{first_sublayer_neuron, neurons.size()}, i});
 
                 // to shift the neuron IDs with the sublayers
                 counter += _numberOfNeurons;
             }
 
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
             }
 
             // building layer structure
-            layers.emplace_back(layer{sublayers, neuronsInLayer, layer_id});
+            add_layer(layer{sublayers, neuronsInLayer, layer_id});
             return layers.back();
         }
 
@@ -664,28 +1344,24 @@ namespace hummus {
             // find number of neurons to build
             int numberOfNeurons = gridW * gridH;
 
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
 
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-                for (auto& l: layers) {
-                    shift += l.neurons.size();
-                }
                 layer_id = layers.back().id+1;
             }
 
             // building a layer of two dimensional sublayers
             int counter = 0;
+            auto& pool = make_neuron_pool<T>(numberOfNeurons * _sublayerNumber);
             std::vector<sublayer> sublayers;
-            std::vector<std::size_t> neuronsInLayer;
+            std::size_t first_neuron = neurons.size();
             for (int i=0; i<_sublayerNumber; i++) {
-                std::vector<std::size_t> neuronsInSublayer;
+                std::size_t first_sublayer_neuron = neurons.size();
                 int x = 0; int y = 0;
                 for (int k=0+shift; k<numberOfNeurons+shift; k++) {
-                    neurons.emplace_back(std::make_unique<T>(k+counter, layer_id, i, 0, std::pair(x, y), std::forward<Args>(args)...));
-                    neuronsInSublayer.emplace_back(neurons.size()-1);
-                    neuronsInLayer.emplace_back(neurons.size()-1);
+                    neurons.emplace_back(pool.emplace(k+counter, layer_id, i, 0, std::pair(x, y), std::forward<Args>(args)...));
 
                     x += 1;
                     if (x == gridW) {
@@ -693,19 +1369,21 @@ namespace hummus {
                         x = 0;
                     }
                 }
-                sublayers.emplace_back(sublayer{{}, neuronsInSublayer, i});
+                sublayers.emplace_back(sublayer{{}, neuron_range{first_sublayer_neuron, neurons.size()}, i});
 
                 // to shift the neuron IDs with the sublayers
                 counter += numberOfNeurons;
             }
 
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
             }
 
             // building layer structure
-            layers.emplace_back(layer{sublayers, neuronsInLayer, layer_id, true, gridW, gridH});
+            add_layer(layer{sublayers, neuronsInLayer, layer_id, true, gridW, gridH});
             return layers.back();
         }
 
@@ -717,7 +1395,7 @@ namespace hummus {
             
         // overloading the makeGrid function to automatically generate a 2D layer according to the previous layer size
         template <typename T, typename... Args>
-        layer make_grid(layer presynapticLayer, int _sublayerNumber, int _kernelSize, int _stride, std::vector<Addon*> _addons, Args&&... args) {
+        layer make_grid(const layer& presynapticLayer, int _sublayerNumber, int _kernelSize, int _stride, std::vector<Addon*> _addons, Args&&... args) {
             // finding the number of receptive fields
             float inv_stride = 1./static_cast<float>(_stride);
             
@@ -737,28 +1415,24 @@ namespace hummus {
             // find number of neurons to build
             int numberOfNeurons = newWidth * newHeight;
 
-            int shift = 0;
+            int shift = static_cast<int>(neurons.size());
 
             // find the layer ID
             int layer_id = 0;
             if (!layers.empty()) {
-                for (auto& l: layers) {
-                    shift += l.neurons.size();
-                }
                 layer_id = layers.back().id+1;
             }
 
             // building a layer of two dimensional sublayers
             int counter = 0;
+            auto& pool = make_neuron_pool<T>(numberOfNeurons * _sublayerNumber);
             std::vector<sublayer> sublayers;
-            std::vector<std::size_t> neuronsInLayer;
+            std::size_t first_neuron = neurons.size();
             for (int i=0; i<_sublayerNumber; i++) {
-                std::vector<std::size_t> neuronsInSublayer;
+                std::size_t first_sublayer_neuron = neurons.size();
                 int x = 0; int y = 0;
                 for (int k=0+shift; k<numberOfNeurons+shift; k++) {
-                    neurons.emplace_back(std::make_unique<T>(k+counter, layer_id, i, 0, std::pair(x, y), std::forward<Args>(args)...));
-                    neuronsInSublayer.emplace_back(neurons.size()-1);
-                    neuronsInLayer.emplace_back(neurons.size()-1);
+                    neurons.emplace_back(pool.emplace(k+counter, layer_id, i, 0, std::pair(x, y), std::forward<Args>(args)...));
 
                     x += 1;
                     if (x == newWidth) {
@@ -766,25 +1440,27 @@ namespace hummus {
                         x = 0;
                     }
                 }
-                sublayers.emplace_back(sublayer{{}, neuronsInSublayer, i});
+                sublayers.emplace_back(sublayer{{}, neuron_range{first_sublayer_neuron, neurons.size()}, i});
 
                 // to shift the neuron IDs with the sublayers
                 counter += numberOfNeurons;
             }
 
+            neuron_range neuronsInLayer{first_neuron, neurons.size()};
+
             // looping through addons and adding the layer to the neuron mask
             for (auto& addon: _addons) {
                 addon->activate_for(neuronsInLayer);
             }
 
             // building layer structure
-            layers.emplace_back(layer{sublayers, neuronsInLayer, layer_id, true, newWidth, newHeight, _kernelSize, _stride});
+            add_layer(layer{sublayers, neuronsInLayer, layer_id, true, newWidth, newHeight, _kernelSize, _stride});
             return layers.back();
         }
 
         // creates a layer that is a subsampled version of the previous layer, to the nearest divisible grid size
         template <typename T, typename... Args>
-        layer make_subsampled_grid(layer presynapticLayer, std::vector<Addon*> _addons, Args&&... args) {
+        layer make_subsampled_grid(const layer& presynapticLayer, std::vector<Addon*> _addons, Args&&... args) {
             // find lowest common divisor
             int lcd = 1;
             for (auto i = 2; i <= presynapticLayer.width && i <= presynapticLayer.height; i++) {
@@ -806,21 +1482,16 @@ namespace hummus {
         }
 
 		// ----- LAYER CONNECTION METHODS -----
-        // connecting a layer that is a convolution of the previous layer, depending on the layer kernel size and the stride. Last set of paramaters are to characterize the synapses. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays. Furthermore, you can select the number of synapses per pair of presynaptic and postsynaptic neurons (the arborescence)
+        // connecting a layer that is a convolution of the previous layer, depending on the layer kernel size and the stride. Last set of paramaters are to characterize the synapses. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays. Furthermore, you can select the number of synapses per pair of presynaptic and postsynaptic neurons (the arborescence). connection_ratio is not applied, every connection of the kernels is made
         template <typename T = Synapse, typename F, typename... Args>
-        void convolution(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
+        void convolution(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
             // error handling
             if (postsynapticLayer.kernel_size == -1 || postsynapticLayer.stride == -1) {
                 throw std::logic_error("cannot connect the layers in a convolutional manner as the layers were not built with that in mind (no kernel or stride in the grid layer to define receptive fields");
             }
 
             // find how many neurons there are before the pre and postsynaptic layers
-            int layershift = 0;
-            if (!layers.empty()) {
-                for (auto i=0; i<presynapticLayer.id; i++) {
-                    layershift += layers[i].neurons.size();
-                }
-            }
+            int layershift = static_cast<int>(presynapticLayer.neurons.first);
             
             int trimmedColumns = presynapticLayer.width - (postsynapticLayer.stride * (postsynapticLayer.width - 1) + postsynapticLayer.kernel_size);
             
@@ -836,12 +1507,13 @@ namespace hummus {
             // number of neurons surrounding the center
             int mooreNeighbors = (2*range + 1) * (2*range + 1);
 
-            int number_of_connections =  static_cast<int>(postsynapticLayer.sublayers.size()) * static_cast<int>(presynapticLayer.sublayers.size()) * static_cast<int>(postsynapticLayer.sublayers[0].neurons.size()) * mooreNeighbors * number_of_synapses;
+            std::size_t number_of_connections = postsynapticLayer.sublayers.size() * presynapticLayer.sublayers.size() * postsynapticLayer.sublayers[0].neurons.size() * static_cast<std::size_t>(mooreNeighbors) * static_cast<std::size_t>(number_of_synapses);
 
-            auto successful_connections = find_successful_connections(connection_ratio, number_of_connections);
+            begin_projection();
 
             // looping through the newly created layer to connect them to the correct receptive fields
-            int conn_idx = 0;
+            std::vector<planned_connection> plan;
+            plan.reserve(number_of_connections);
             for (auto& convSub: postsynapticLayer.sublayers) {
                 int sublayershift = 0;
                 for (auto& preSub: presynapticLayer.sublayers) {
@@ -861,7 +1533,7 @@ namespace hummus {
                             int y = centerCoordinates.second + ((i / postsynapticLayer.kernel_size) - range);
 
                             // 2D to 1D mapping to get the index from x y coordinates
-                            int idx = (x + presynapticLayer.width * y) + layershift + sublayershift;
+                            int idx = get_neuron_index((x + presynapticLayer.width * y) + layershift + sublayershift);
 
                             // changing the neuron's receptive field id from the default
                             neurons[idx]->set_rf_id(rf_id);
@@ -869,15 +1541,7 @@ namespace hummus {
 
                             // connecting neurons from the presynaptic layer to the convolutional one, depedning on the number of synapses
                             for (auto i=0; i<number_of_synapses; i++) {
-                                // calculating weights and delays according to the provided distribution
-                                const std::pair weight_delay = lambdaFunction(x, y, convSub.id, random_engine);
-
-                                // creating a synapse between the neurons
-                                neurons[idx]->make_synapse<T>(neurons[n].get(), weight_delay.first, weight_delay.second, std::forward<Args>(args)...);
-
-                                // to shift the network runtime by the maximum delay in the clock mode
-                                max_delay = std::max(max_delay, weight_delay.second);
-                                conn_idx++;
+                                plan.emplace_back(planned_connection{static_cast<std::size_t>(idx), n, x, y, convSub.id, static_cast<std::uint32_t>(i)});
                             }
                         }
 
@@ -898,23 +1562,21 @@ namespace hummus {
                     sublayershift += preSub.neurons.size();
                 }
             }
+
+            // creating the synapses with weights and delays drawn from the provided distribution
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return weight_delay; }, true, std::forward<Args>(args)...);
         }
         
-        // connecting a subsampled layer to its previous layer. Last set of paramaters are to characterize the synapses. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays
+        // connecting a subsampled layer to its previous layer. Last set of paramaters are to characterize the synapses. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays. connection_ratio is not applied, every connection of the pooling windows is made
         template <typename T = Synapse, typename F, typename... Args>
-        void pooling(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
+        void pooling(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
             // error handling
             if (postsynapticLayer.id - presynapticLayer.id > 1) {
                 throw std::logic_error("the layers aren't immediately following each other");
             }
             
             // find how many neurons there are before the pre and postsynaptic layers
-            int layershift = 0;
-            if (!layers.empty()) {
-                for (auto i=0; i<presynapticLayer.id; i++) {
-                    layershift += layers[i].neurons.size();
-                }
-            }
+            int layershift = static_cast<int>(presynapticLayer.neurons.first);
 
             float range;
             int lcd = presynapticLayer.width / postsynapticLayer.width;
@@ -931,11 +1593,12 @@ namespace hummus {
             // number of neurons surrounding the center
             int mooreNeighbors = (2*range + 1) * (2*range + 1);
 
-            int number_of_connections = static_cast<int>(presynapticLayer.sublayers.size()) * static_cast<int>(postsynapticLayer.sublayers[0].neurons.size()) * mooreNeighbors * number_of_synapses;
+            std::size_t number_of_connections = presynapticLayer.sublayers.size() * postsynapticLayer.sublayers[0].neurons.size() * static_cast<std::size_t>(mooreNeighbors) * static_cast<std::size_t>(number_of_synapses);
 
-            auto successful_connections = find_successful_connections(connection_ratio, number_of_connections);
+            begin_projection();
 
-            int conn_idx = 0;
+            std::vector<planned_connection> plan;
+            plan.reserve(number_of_connections);
             for (auto& poolSub: postsynapticLayer.sublayers) {
                 int sublayershift = 0;
                 for (auto& preSub: presynapticLayer.sublayers) {
@@ -957,22 +1620,15 @@ namespace hummus {
                                 int y = centerCoordinates.second + ((i / lcd) - range);
 
                                 // 2D to 1D mapping to get the index from x y coordinates
-                                int idx = (x + presynapticLayer.width * y) + layershift + sublayershift;
+                                int idx = get_neuron_index((x + presynapticLayer.width * y) + layershift + sublayershift);
 
                                 // changing the neuron's receptive field coordinates from the default
                                 neurons[idx]->set_rf_id(rf_id);
                                 rf_neurons.emplace_back(static_cast<size_t>(idx));
 
                                 for (auto i=0; i<number_of_synapses; i++) {
-                                    // calculating weights and delays according to the provided distribution
-                                    const std::pair weight_delay = lambdaFunction(x, y, poolSub.id, random_engine);
-
                                     // connecting neurons from the presynaptic layer to the convolutional one
-                                    neurons[idx]->make_synapse<T>(neurons[n].get(), weight_delay.first, weight_delay.second, std::forward<Args>(args)...);
-
-                                    // to shift the network runtime by the maximum delay in the clock mode
-                                    max_delay = std::max(max_delay, weight_delay.second);
-                                    conn_idx++;
+                                    plan.emplace_back(planned_connection{static_cast<std::size_t>(idx), n, x, y, poolSub.id, static_cast<std::uint32_t>(i)});
                                 }
                             }
 
@@ -993,56 +1649,63 @@ namespace hummus {
                     sublayershift += preSub.neurons.size();
                 }
             }
+
+            // creating the synapses with weights and delays drawn from the provided distribution
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return weight_delay; }, true, std::forward<Args>(args)...);
         }
         
         // interconnecting a layer (feedforward, feedback and self-excitation) with randomised weights and delays. lambdaFunction: Takes in one of the classes inside the randomDistributions folder to define a distribution for the weights.
         template <typename T = Synapse, typename F, typename... Args>
-        void reservoir(layer reservoirLayer, int number_of_synapses, F&& lambdaFunction, int feedforward_connection_ratio, int feedback_connection_ratio, int self_excitation_connection_ratio, Args&&... args) {
+        void reservoir(const layer& reservoirLayer, int number_of_synapses, F&& lambdaFunction, int feedforward_connection_ratio, int feedback_connection_ratio, int self_excitation_connection_ratio, Args&&... args) {
+
+            begin_projection();
 
-            int number_of_feedforward = (static_cast<int>(reservoirLayer.neurons.size()) - 1) * (static_cast<int>(reservoirLayer.neurons.size()) - 1) * number_of_synapses;
+            std::size_t number_of_feedforward = reservoirLayer.neurons.size() * (reservoirLayer.neurons.size() - 1) * static_cast<std::size_t>(number_of_synapses);
             auto successful_feedforward = find_successful_connections(feedforward_connection_ratio, number_of_feedforward);
 
-            int number_of_feedback = (static_cast<int>(reservoirLayer.neurons.size()) - 1) * (static_cast<int>(reservoirLayer.neurons.size()) - 1) * number_of_synapses;
+            std::size_t number_of_feedback = reservoirLayer.neurons.size() * (reservoirLayer.neurons.size() - 1) * static_cast<std::size_t>(number_of_synapses);
             auto successful_feedback = find_successful_connections(feedback_connection_ratio, number_of_feedback);
 
-            int number_of_self_excitation = static_cast<int>(reservoirLayer.neurons.size()) * number_of_synapses;
+            std::size_t number_of_self_excitation = reservoirLayer.neurons.size() * static_cast<std::size_t>(number_of_synapses);
             auto successful_self_excitation = find_successful_connections(self_excitation_connection_ratio, number_of_self_excitation);
 
-            int idx = 0;
-            int idx_se = 0;
-            // connecting the reservoir
+            // without a seed, a weight is drawn from the shared random engine for every pair, kept or not, so the rejected pairs stay in the plan
+            bool draw_every_pair = !seeded_construction;
+
+            std::vector<planned_connection> plan;
+            std::size_t idx = 0;
+            std::size_t idx_se = 0;
+            // connecting the reservoir. the feedforward and feedback synapses of a pair share their weight
             for (auto pre: reservoirLayer.neurons) {
                 for (auto post: reservoirLayer.neurons) {
                     for (auto i=0; i<number_of_synapses; i++) {
-                        // calculating weights and delays according to the provided distribution
-                        const std::pair weight_delay = lambdaFunction(0, 0, 0, random_engine);
-
                         // self-excitation connection_ratio
                         if (pre == post) {
-                            if (successful_self_excitation[idx_se]) {
-                                neurons[pre]->make_synapse<T>(neurons[post].get(), weight_delay.first, weight_delay.first, std::forward<Args>(args)...);
+                            bool self_excitation = successful_self_excitation.selected(idx_se);
+                            if (self_excitation || draw_every_pair) {
+                                plan.emplace_back(planned_connection{pre, post, 0, 0, 0, static_cast<std::uint32_t>(i), self_excitation});
                             }
                             idx_se++;
                         } else {
-                            // feedforward connection_ratio
-                            if (successful_feedforward[idx]) {
-                                neurons[pre]->make_synapse<T>(neurons[post].get(), weight_delay.first, weight_delay.first, std::forward<Args>(args)...);
-                            }
-
-                            // feedback connection_ratio
-                            if (successful_feedback[idx]) {
-                                neurons[post]->make_synapse<T>(neurons[pre].get(), weight_delay.first, weight_delay.first, std::forward<Args>(args)...);
+                            // feedforward and feedback connection_ratio
+                            bool feedforward = successful_feedforward.selected(idx);
+                            bool feedback = successful_feedback.selected(idx);
+                            if (feedforward || feedback || draw_every_pair) {
+                                plan.emplace_back(planned_connection{pre, post, 0, 0, 0, static_cast<std::uint32_t>(i), feedforward, feedback});
                             }
                             idx++;
                         }
                     }
                 }
             }
+
+            // the drawn weight is also used as the delay
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return std::make_pair(weight_delay.first, weight_delay.first); }, false, std::forward<Args>(args)...);
         }
         
 		// connecting two layers according to a weight matrix vector of vectors and a delays matrix vector of vectors (columns for input and rows for output)
         template <typename T = Synapse, typename... Args>
-        void connectivity_matrix(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, std::vector<std::vector<float>> weights, std::vector<std::vector<float>> delays, Args&&... args) {
+        void connectivity_matrix(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, const std::vector<std::vector<float>>& weights, const std::vector<std::vector<float>>& delays, Args&&... args) {
 
             // error handling
             
@@ -1084,17 +1747,53 @@ namespace hummus {
             }
         }
 
+        // connecting two layers according to sparse connections (see sparse_connectivity and DataParser::read_sparse_connectivity). rows are the presynaptic neurons and columns the postsynaptic neurons, in the order of their layer. unlike the dense matrix, every stored connection is created even if its weight is 0
+        template <typename T = Synapse, typename... Args>
+        void connectivity_matrix(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, const sparse_connectivity& matrix, Args&&... args) {
+            // error handling
+            if (matrix.row_offsets.size() != matrix.rows + 1 || matrix.weights.size() != matrix.size() || matrix.delays.size() != matrix.size()) {
+                throw std::logic_error("the sparse connectivity is not a valid CSR structure");
+            }
+
+            if (matrix.rows > presynapticLayer.neurons.size()) {
+                throw std::logic_error("the presynaptic layer doesn't contain as many neurons as represented in the matrix");
+            }
+
+            if (matrix.columns > postsynapticLayer.neurons.size() || std::any_of(matrix.column_indices.begin(), matrix.column_indices.end(), [&](std::uint32_t column) { return column >= postsynapticLayer.neurons.size(); })) {
+                throw std::logic_error("the postsynaptic layer doesn't contain as many neurons as represented in the matrix");
+            }
+
+            for (std::size_t row=0; row<matrix.rows; ++row) {
+                auto& preNeuron = neurons[presynapticLayer.neurons[row]];
+                preNeuron->get_axon_terminals().reserve(preNeuron->get_axon_terminals().size() + (matrix.row_offsets[row+1] - matrix.row_offsets[row]) * number_of_synapses);
+
+                for (auto entry=matrix.row_offsets[row]; entry<matrix.row_offsets[row+1]; ++entry) {
+                    auto& postNeuron = neurons[postsynapticLayer.neurons[matrix.column_indices[entry]]];
+                    for (auto i=0; i<number_of_synapses; i++) {
+                        preNeuron->make_synapse<T>(postNeuron.get(), matrix.weights[entry], matrix.delays[entry], args...);
+                    }
+
+                    // to shift the network runtime by the maximum delay in the clock mode
+                    max_delay = std::max(max_delay, matrix.delays[entry]);
+                }
+            }
+        }
+
         // one to one connections between layers. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays
         template <typename T = Synapse, typename F, typename... Args>
-        void one_to_one(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
+        void one_to_one(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
             // error handling
             if (presynapticLayer.neurons.size() != postsynapticLayer.neurons.size() && presynapticLayer.width == postsynapticLayer.width && presynapticLayer.height == postsynapticLayer.height) {
                 throw std::logic_error("The presynaptic and postsynaptic layers do not have the same number of neurons. Cannot do a one-to-one connection");
             }
 
-            int number_of_connections = static_cast<int>(presynapticLayer.neurons.size()) * number_of_synapses;
+            std::size_t number_of_connections = presynapticLayer.neurons.size() * static_cast<std::size_t>(number_of_synapses);
+            begin_projection();
             auto successful_connections = find_successful_connections(connection_ratio, number_of_connections);
-            int idx = 0;
+
+            std::vector<planned_connection> plan;
+            plan.reserve(successful_connections.expected_selections());
+            std::size_t idx = 0;
             for (int preSubIdx=0; preSubIdx<static_cast<int>(presynapticLayer.sublayers.size()); preSubIdx++) {
                 for (int preNeuronIdx=0; preNeuronIdx<static_cast<int>(presynapticLayer.sublayers[preSubIdx].neurons.size()); preNeuronIdx++) {
                     for (int postSubIdx=0; postSubIdx<static_cast<int>(postsynapticLayer.sublayers.size()); postSubIdx++) {
@@ -1102,13 +1801,9 @@ namespace hummus {
                             if (preNeuronIdx == postNeuronIdx) {
                                 for (int i=0; i<number_of_synapses; i++) {
 
-                                    if (successful_connections[idx]) {
-
-                                        const std::pair weight_delay = lambdaFunction(neurons[postsynapticLayer.sublayers[postSubIdx].neurons[postNeuronIdx]]->get_xy_coordinates().first, neurons[postsynapticLayer.sublayers[postSubIdx].neurons[postNeuronIdx]]->get_xy_coordinates().second, postsynapticLayer.sublayers[postSubIdx].id, random_engine);
-                                    neurons[presynapticLayer.sublayers[preSubIdx].neurons[preNeuronIdx]]->make_synapse<T>(neurons[postsynapticLayer.sublayers[postSubIdx].neurons[postNeuronIdx]].get(), weight_delay.first, weight_delay.second, std::forward<Args>(args)...);
-
-                                        // to shift the network runtime by the maximum delay in the clock mode
-                                        max_delay = std::max(max_delay, weight_delay.second);
+                                    if (successful_connections.selected(idx)) {
+                                        auto postNeuron = postsynapticLayer.sublayers[postSubIdx].neurons[postNeuronIdx];
+                                        plan.emplace_back(planned_connection{presynapticLayer.sublayers[preSubIdx].neurons[preNeuronIdx], postNeuron, neurons[postNeuron]->get_xy_coordinates().first, neurons[postNeuron]->get_xy_coordinates().second, postsynapticLayer.sublayers[postSubIdx].id, static_cast<std::uint32_t>(i)});
                                     }
 
                                     idx++;
@@ -1118,23 +1813,25 @@ namespace hummus {
                     }
                 }
             }
+
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return weight_delay; }, true, std::forward<Args>(args)...);
         }
         
         template <typename T = Synapse, typename F, typename... Args>
-        void random_to_all(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, F&& lambdaFunction, Args&&... args) {
+        void random_to_all(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, F&& lambdaFunction, Args&&... args) {
             std::uniform_int_distribution<> uniform(2, static_cast<int>(presynapticLayer.neurons.size()));
             std::vector<int> sensors(presynapticLayer.neurons.size());
             std::iota(sensors.begin(), sensors.end(), 0);
 
-            // looping through postsynaptic neurons
-            for (auto& postNeuron: postsynapticLayer.neurons) {
+            begin_projection();
+            auto connect_sensors = [&](auto& engine, std::size_t postNeuron) {
                 auto number_of_sensors = 0;
                 if (number_of_synapses > 1) {
                     number_of_sensors = number_of_synapses;
                 } else {
-                    number_of_sensors = uniform(random_engine);
+                    number_of_sensors = uniform(engine);
                 }
-                std::shuffle(sensors.begin(), sensors.end(), random_engine);
+                std::shuffle(sensors.begin(), sensors.end(), engine);
 
                 // fixed weight depending on number of presynaptic neurons used
                 float weight = 1. / number_of_sensors;
@@ -1145,36 +1842,44 @@ namespace hummus {
                     auto& preNeuron = sensors[i];
 
                     // delay randomisation
-                    const std::pair weight_delay = lambdaFunction(0, 0, 0, random_engine);
+                    const std::pair weight_delay = lambdaFunction(0, 0, 0, engine);
 
                     neurons[preNeuron]->make_synapse<T>(neurons[postNeuron].get(), weight, weight_delay.second, std::forward<Args>(args)...);
 
                     max_delay = std::max(max_delay, weight_delay.second);
                 }
+            };
+
+            // looping through postsynaptic neurons. with a construction seed every postsynaptic neuron draws from its own stream
+            for (auto& postNeuron: postsynapticLayer.neurons) {
+                if (seeded_construction) {
+                    auto stream = connection_stream(postNeuron, postNeuron, std::numeric_limits<std::uint32_t>::max());
+                    connect_sensors(stream, postNeuron);
+                } else {
+                    connect_sensors(random_engine, postNeuron);
+                }
             }
         }
         
         // all to all connection between layers. lambdaFunction: Takes in either a lambda function (operating on x, y and the sublayer depth) or one of the classes inside the randomDistributions folder to define a distribution for the weights and delays
         template <typename T = Synapse, typename F, typename... Args>
-        void all_to_all(layer presynapticLayer, layer postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
+        void all_to_all(const layer& presynapticLayer, const layer& postsynapticLayer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
             
-            int number_of_connections = static_cast<int>(presynapticLayer.neurons.size()) * static_cast<int>(postsynapticLayer.neurons.size()) * number_of_synapses;
+            std::size_t number_of_connections = presynapticLayer.neurons.size() * postsynapticLayer.neurons.size() * static_cast<std::size_t>(number_of_synapses);
+            begin_projection();
             auto successful_connections = find_successful_connections(connection_ratio, number_of_connections);
 
-            int idx = 0;
+            std::vector<planned_connection> plan;
+            plan.reserve(successful_connections.expected_selections());
+            std::size_t idx = 0;
             for (auto& preSub: presynapticLayer.sublayers) {
                 for (auto& preNeuron: preSub.neurons) {
                     for (auto& postSub: postsynapticLayer.sublayers) {
                         for (auto& postNeuron: postSub.neurons) {
                             for (auto i=0; i<number_of_synapses; i++) {
 
-                                if (successful_connections[idx]) {
-                                    const std::pair weight_delay = lambdaFunction(neurons[postNeuron]->get_xy_coordinates().first, neurons[postNeuron]->get_xy_coordinates().second, postSub.id, random_engine);
-
-                                    neurons[preNeuron]->make_synapse<T>(neurons[postNeuron].get(), weight_delay.first, weight_delay.second, std::forward<Args>(args)...);
-
-                                    // to shift the network runtime by the maximum delay in the clock mode
-                                    max_delay = std::max(max_delay, weight_delay.second);
+                                if (successful_connections.selected(idx)) {
+                                    plan.emplace_back(planned_connection{preNeuron, postNeuron, neurons[postNeuron]->get_xy_coordinates().first, neurons[postNeuron]->get_xy_coordinates().second, postSub.id, static_cast<std::uint32_t>(i)});
                                 }
 
                                 idx++;
@@ -1183,17 +1888,19 @@ namespace hummus {
                     }
                 }
             }
+
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return weight_delay; }, true, std::forward<Args>(args)...);
         }
         
         // overloading all_to_all with one synapse and 100% connection success
         template <typename T = Synapse, typename F, typename... Args>
-        void all_to_all(layer presynapticLayer, layer postsynapticLayer, F&& lambdaFunction, Args&&... args) {
+        void all_to_all(const layer& presynapticLayer, const layer& postsynapticLayer, F&& lambdaFunction, Args&&... args) {
             all_to_all<T>(presynapticLayer, postsynapticLayer, 1, lambdaFunction, 100, std::forward<Args>(args)...);
         }
         
-        // interconnecting a layer with soft winner-takes-all synapses, using negative weights
+        // interconnecting a layer with soft winner-takes-all synapses, using negative weights. connection_ratio is not applied, every pair of neurons is connected
         template <typename T = Synapse, typename F, typename... Args>
-        void lateral_inhibition(layer current_layer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
+        void lateral_inhibition(const layer& current_layer, int number_of_synapses, F&& lambdaFunction, int connection_ratio, Args&&... args) {
 
             size_t number_of_connections = 0;
             auto& l = layers[current_layer.id];
@@ -1209,18 +1916,17 @@ namespace hummus {
                 number_of_connections = intra_connections + inter_connections;
             }
 
-            auto successful_connections = find_successful_connections(connection_ratio, static_cast<int>(number_of_connections));
+            begin_projection();
 
-            int idx = 0;
+            std::vector<planned_connection> plan;
+            plan.reserve(number_of_connections);
             for (auto& sub: l.sublayers) {
                 // intra-sublayer soft WTA
                 for (auto& preNeurons: sub.neurons) {
                     for (auto& postNeurons: sub.neurons) {
                         if (preNeurons != postNeurons && neurons[preNeurons]->get_rf_id() == neurons[postNeurons]->get_rf_id()) {
                             for (auto i=0; i<number_of_synapses; i++) {
-                                const std::pair weight_delay = lambdaFunction(0, 0, 0, random_engine);
-                                neurons[preNeurons]->make_synapse<T>(neurons[postNeurons].get(), -1*std::abs(weight_delay.first), weight_delay.second, std::forward<Args>(args)...);
-                                idx++;
+                                plan.emplace_back(planned_connection{preNeurons, postNeurons, 0, 0, 0, static_cast<std::uint32_t>(i)});
                             }
                         }
                     }
@@ -1233,9 +1939,7 @@ namespace hummus {
                             for (auto& postNeurons: subToInhibit.neurons) {
                                 if (neurons[preNeurons]->get_rf_id() == neurons[postNeurons]->get_rf_id()) {
                                     for (auto i=0; i<number_of_synapses; i++) {
-                                        const std::pair weight_delay = lambdaFunction(0, 0, 0, random_engine);
-                                        neurons[preNeurons]->make_synapse<T>(neurons[postNeurons].get(), -1*std::abs(weight_delay.first), weight_delay.second, std::forward<Args>(args)...);
-                                        idx++;
+                                        plan.emplace_back(planned_connection{preNeurons, postNeurons, 0, 0, 0, static_cast<std::uint32_t>(i)});
                                     }
                                 }
                             }
@@ -1243,13 +1947,90 @@ namespace hummus {
                     }
                 }
             }
+
+            // inhibitory synapses: negative weights
+            build_connections<T>(plan, lambdaFunction, [](std::pair<float, float> weight_delay) { return std::make_pair(-1*std::abs(weight_delay.first), weight_delay.second); }, false, std::forward<Args>(args)...);
         }
         
         // overloading all_to_all with one synapse and 100% connection success
         template <typename T = Synapse, typename F, typename... Args>
-        void lateral_inhibition(layer current_layer, F&& lambdaFunction, Args&&... args) {
+        void lateral_inhibition(const layer& current_layer, F&& lambdaFunction, Args&&... args) {
             lateral_inhibition<T>(current_layer, 1, lambdaFunction, 100, std::forward<Args>(args)...);
         }
+
+        // lateral inhibition without synapses. without a radius, every neuron inhibits the other neurons with the same receptive field, like lateral_inhibition. with a radius, a neuron of a grid layer inhibits the neurons within radius of its coordinates (including the ones at the same position in the other sublayers for the layer scope). the inhibition behaves like Exponential synapses with the same weight and delay, and only works in the clock mode. returns a reference to the inhibition
+        LateralInhibition& implicit_lateral_inhibition(const layer& current_layer, float weight, float delay=0, int radius=-1, inhibition_scope scope=inhibition_scope::layer, float synapse_time_constant=10, float external_current=100) {
+            auto& l = layers[current_layer.id];
+            if (l.neurons.empty()) {
+                throw std::logic_error("the layer has no neurons to inhibit");
+            }
+
+            if (radius >= 0 && (l.width <= 0 || l.height <= 0)) {
+                throw std::logic_error("an inhibition radius needs a grid layer, build it with make_grid");
+            }
+
+            // cells gathering the neurons that inhibit each other
+            std::vector<std::size_t> home_cells(l.neurons.size());
+            std::vector<std::size_t> offsets(1, 0);
+            std::vector<std::size_t> neighbourhoods;
+            if (radius < 0) {
+                std::map<std::pair<int, int>, std::size_t> cell_ids;
+                for (auto& sub: l.sublayers) {
+                    for (auto n: sub.neurons) {
+                        auto key = std::make_pair(scope == inhibition_scope::sublayer ? sub.id : 0, neurons[n]->get_rf_id());
+                        auto cell = cell_ids.emplace(key, cell_ids.size()).first->second;
+                        home_cells[n - l.neurons.first] = cell;
+                    }
+                }
+
+                for (std::size_t cell=0; cell<cell_ids.size(); ++cell) {
+                    neighbourhoods.emplace_back(cell);
+                    offsets.emplace_back(neighbourhoods.size());
+                }
+            } else {
+                auto area = static_cast<std::size_t>(l.width) * l.height;
+                auto planes = scope == inhibition_scope::sublayer ? l.sublayers.size() : 1;
+                for (auto& sub: l.sublayers) {
+                    for (auto n: sub.neurons) {
+                        auto xy = neurons[n]->get_xy_coordinates();
+                        home_cells[n - l.neurons.first] = (scope == inhibition_scope::sublayer ? sub.id * area : 0) + static_cast<std::size_t>(xy.second * l.width + xy.first);
+                    }
+                }
+
+                for (std::size_t plane=0; plane<planes; ++plane) {
+                    for (int y=0; y<l.height; ++y) {
+                        for (int x=0; x<l.width; ++x) {
+                            for (int ny=std::max(0, y-radius); ny<=std::min(l.height-1, y+radius); ++ny) {
+                                for (int nx=std::max(0, x-radius); nx<=std::min(l.width-1, x+radius); ++nx) {
+                                    neighbourhoods.emplace_back(plane * area + static_cast<std::size_t>(ny * l.width + nx));
+                                }
+                            }
+                            offsets.emplace_back(neighbourhoods.size());
+                        }
+                    }
+                }
+            }
+
+            for (auto n: l.neurons) {
+                if (!neurons[n]->integrates_lateral_inhibition()) {
+                    throw std::logic_error("the neurons of the layer do not support the implicit lateral inhibition, use CUBA_LIF or Static_CUBA_LIF");
+                }
+
+                if (neurons[n]->get_lateral_inhibition()) {
+                    throw std::logic_error("a neuron can only belong to one implicit lateral inhibition");
+                }
+            }
+
+            lateral_inhibitions.emplace_back(new LateralInhibition(l.id, l.neurons.first, std::move(home_cells), std::move(offsets), std::move(neighbourhoods), weight, delay, synapse_time_constant, external_current));
+            auto& inhibition = *lateral_inhibitions.back();
+            for (auto n: l.neurons) {
+                neurons[n]->set_lateral_inhibition(&inhibition);
+            }
+
+            // to shift the network runtime by the maximum delay in the clock mode
+            max_delay = std::max(max_delay, delay);
+            return inhibition;
+        }
         
         // ----- PUBLIC NETWORK METHODS -----
         // adds a spike to the priority queue
@@ -1259,7 +2040,8 @@ namespace hummus {
 
         // overloaded method - creates a spike and adds it to the spike_queue priority queue
         void inject_spike(int neuronIndex, double timestamp, spike_type type = spike_type::initial) {
-            spike_queue.emplace(neurons.at(neuronIndex)->receive_external_input(timestamp, type, neuronIndex, -1, 1, 0));
+            int idx = get_neuron_index(neuronIndex);
+            spike_queue.emplace(neurons.at(idx)->receive_external_input(timestamp, type, idx, -1, 1, 0));
         }
 
         // adding spikes predicted by the asynchronous network (timestep = 0) for synaptic integration
@@ -1327,8 +2109,9 @@ namespace hummus {
             std::transform(spike_times.begin(), spike_times.end(), spike_times.begin(), [&](double& st){return st*0.001+timestamp;});
 
             // injecting into the initial spike vector
+            int idx = get_neuron_index(neuronIndex);
             for (auto& spike_time: spike_times) {
-                spike_queue.emplace(neurons[neuronIndex]->receive_external_input(spike_time, spike_type::initial, neuronIndex, -1, 1, 0));
+                spike_queue.emplace(neurons[idx]->receive_external_input(spike_time, spike_type::initial, idx, -1, 1, 0));
             }
         }
 
@@ -1361,6 +2144,12 @@ namespace hummus {
                 asynchronous = true;
             }
 
+            // the inhibitions are only delivered when the neurons are updated every timestep
+            if (asynchronous && !lateral_inhibitions.empty()) {
+                throw std::logic_error("the implicit lateral inhibition is not compatible with the event-based mode");
+            }
+
+            bind_addons();
             for (auto& n: neurons) {
                 n->initialisation(this);
             }
@@ -1375,7 +2164,8 @@ namespace hummus {
             }
 
             std::atomic_bool running(true);
-            std::thread spikeManager([&] {
+            std::exception_ptr error;
+            auto spikeManager = presentation_thread(running, error, [&]() {
                 sync.lock();
                 sync.unlock();
 
@@ -1403,6 +2193,9 @@ namespace hummus {
             }
 
             spikeManager.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
         }
 
         // running through the network asynchronously if timestep = 0 and synchronously otherwise. This method takes in a vector of inputs from the read_txt_data method
@@ -1417,6 +2210,12 @@ namespace hummus {
                 asynchronous = true;
             }
 
+            // the inhibitions are only delivered when the neurons are updated every timestep
+            if (asynchronous && !lateral_inhibitions.empty()) {
+                throw std::logic_error("the implicit lateral inhibition is not compatible with the event-based mode");
+            }
+
+            bind_addons();
             for (auto& n: neurons) {
                 n->initialisation(this);
             }
@@ -1431,7 +2230,8 @@ namespace hummus {
             }
 
             std::atomic_bool running(true);
-            std::thread spikeManager([&] {
+            std::exception_ptr error;
+            auto spikeManager = presentation_thread(running, error, [&]() {
                 sync.lock();
                 sync.unlock();
 
@@ -1462,7 +2262,7 @@ namespace hummus {
                     
                     // can now propagate to decision-making layer if present
                     if (decision_making) {
-                        layers[decision.layer_number].active = true;
+                        activate_layer(decision.layer_number);
                         prepare_decision_making();
                     }
                     
@@ -1471,6 +2271,7 @@ namespace hummus {
                         if (verbose != 0) {
                             std::cout << "training logistic regression" << std::endl;
                         }
+                        touch_neuron(layers[decision.layer_number].neurons[0]);
                         neurons[layers[decision.layer_number].neurons[0]]->update(0, nullptr, this, 0, spike_type::none);
                     }
                     
@@ -1516,34 +2317,38 @@ namespace hummus {
             }
 
             spikeManager.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
         }
 
         // running through a database of .npy files synchronously or asynchronously - relies on the numpy header
         void run_npy_database(const std::vector<std::string>& training_database, float _timestep=0, const std::vector<std::string>& testing_database={}, int scaling_factor=1) {
             
-            // lambda function to inject from npy files
-            auto inject_npy = [&](std::string filename, int scaling_factor=1) -> double {
-                std::vector<int> size;
-                std::vector<double> data;
-                double final_time=0;
-                aoba::LoadArrayFromNumpy(filename, size, data);
-                
-                if (size[0] == 2) {
-                    for (auto i=0; i<size[1]; ++i) {
-                        inject_spike(static_cast<int>(data[i+size[1]]), data[i]*scaling_factor);
-                        final_time = std::max(final_time, data[i]*scaling_factor);
-                    }
-                } else {
-                    throw std::logic_error(filename.append(" is formatted incorrectly. npy files only accept 1D data formatted as such: [t, neuron_id]. for 2D data, using the methods associated with the .es format is preferrable"));
+            // lambda function to inject the spikes of a loaded npy file
+            auto inject_npy = [&](const npy_presentation& presentation) -> double {
+                for (auto& s: presentation.spikes) {
+                    inject_spike(s.first, s.second);
                 }
-                
-                return final_time;
+                return presentation.final_time;
             };
             
             if (_timestep == 0) {
                 asynchronous = true;
             }
 
+            if (checkpoint_interval > 0) {
+                check_checkpointable();
+            }
+
+            auto first_training_file = resume_training(training_database);
+
+            // the inhibitions are only delivered when the neurons are updated every timestep
+            if (asynchronous && !lateral_inhibitions.empty()) {
+                throw std::logic_error("the implicit lateral inhibition is not compatible with the event-based mode");
+            }
+
+            bind_addons();
             for (auto& n: neurons) {
                 n->initialisation(this);
             }
@@ -1552,13 +2357,20 @@ namespace hummus {
                 addon->on_start(this);
             }
 
+            // the remaining training files then the testing files are loaded in the background in the order they are presented
+            auto training_files = training_database.size() - first_training_file;
+            prefetcher<npy_presentation> files(training_files + testing_database.size(), [&](std::size_t i) {
+                return load_npy_file(i < training_files ? training_database[first_training_file + i] : testing_database[i - training_files], scaling_factor);
+            }, prefetch_depth, prefetch_threads);
+
             std::mutex sync;
             if (th_addon) {
                 sync.lock();
             }
 
             std::atomic_bool running(true);
-            auto loop = std::thread([&]() {
+            std::exception_ptr error;
+            auto loop = presentation_thread(running, error, [&]() {
                 sync.lock();
                 sync.unlock();
                 
@@ -1567,8 +2379,9 @@ namespace hummus {
                     std::cout << "Running training instance..." << std::endl;
                 }
 
-                // loop through each .es file in the training database
-                for (auto filename : training_database) {
+                // loop through each file in the training database, after the ones a loaded checkpoint was already trained on
+                for (auto idx=first_training_file; idx<training_database.size(); ++idx) {
+                    auto& filename = training_database[idx];
                     
                     if (verbose >= 1) {
                         std::cout << filename << std::endl;
@@ -1578,7 +2391,7 @@ namespace hummus {
                         break;
                     }
                     
-                    auto end_time = inject_npy(filename, scaling_factor);
+                    auto end_time = inject_npy(files.next());
                     
                     if (_timestep == 0) {
                         async_run_helper(&running, false);
@@ -1592,14 +2405,18 @@ namespace hummus {
                     }
                     
                     // send a decision spike to the computation layer of the regression neurons
-                    if (logistic_regression && decision.timer == 0 && layers[decision.layer_number].active) {
+                    if (logistic_regression && decision.timer == 0 && is_layer_active(decision.layer_number)) {
+                        touch_neuron(layers[decision.layer_number].neurons[0]);
                         neurons[layers[decision.layer_number].neurons[0]]->update(end_time, nullptr, this, 0, spike_type::decision);
                     }
                     
                     presentation_counter++;
                     
                     reset_network(false);
+
+                    save_training_checkpoint(training_database, idx+1);
                 }
+                training_position = 0;
                 
                 std::chrono::duration<float> elapsed_seconds = std::chrono::system_clock::now()-start;
                 if (verbose != 0) {
@@ -1613,12 +2430,13 @@ namespace hummus {
 
                     // can now propagate to decision-making layer if present
                     if (decision_making) {
-                       layers[decision.layer_number].active = true;
+                       activate_layer(decision.layer_number);
                        prepare_decision_making();
                     }
 
                     // test logistic regression if available
                     if (logistic_regression) {
+                       touch_neuron(layers[decision.layer_number].neurons[0]);
                        neurons[layers[decision.layer_number].neurons[0]]->update(0, nullptr, this, 0, spike_type::none);
                     }
 
@@ -1646,7 +2464,7 @@ namespace hummus {
                             break;
                         }
                         
-                        auto end_time = inject_npy(filename, scaling_factor);
+                        auto end_time = inject_npy(files.next());
                         
                         if (_timestep == 0) {
                             async_run_helper(&running, true);
@@ -1694,13 +2512,33 @@ namespace hummus {
             }
 
             loop.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
         }
         
         // running asynchronously through a database of .es files - relies on the sepia header
         void run_es_database(const std::vector<std::string>& training_database, const std::vector<std::string>& testing_database={}, uint64_t t_max=UINT64_MAX, uint64_t t_min=0, int polarity=2, uint16_t x_max=UINT16_MAX, uint16_t x_min=0, uint16_t y_max=UINT16_MAX, uint16_t y_min=0) {
 
+            // error handling
+            if (polarity < 0 || polarity > 2) {
+                throw std::logic_error("polarity is 0 for OFF events, 1 for ON events and 2 for both");
+            }
+
             asynchronous = true;
 
+            if (checkpoint_interval > 0) {
+                check_checkpointable();
+            }
+
+            auto first_training_file = resume_training(training_database);
+
+            // the inhibitions are only delivered when the neurons are updated every timestep
+            if (asynchronous && !lateral_inhibitions.empty()) {
+                throw std::logic_error("the implicit lateral inhibition is not compatible with the event-based mode");
+            }
+
+            bind_addons();
             for (auto& n: neurons) {
                 n->initialisation(this);
             }
@@ -1709,13 +2547,20 @@ namespace hummus {
                 addon->on_start(this);
             }
 
+            // the remaining training files then the testing files are decoded in the background in the order they are presented
+            auto training_files = training_database.size() - first_training_file;
+            prefetcher<es_presentation> files(training_files + testing_database.size(), [&](std::size_t i) {
+                return load_es_file(i < training_files ? training_database[first_training_file + i] : testing_database[i - training_files], t_max, t_min, polarity, x_max, x_min, y_max, y_min);
+            }, prefetch_depth, prefetch_threads);
+
             std::mutex sync;
             if (th_addon) {
                 sync.lock();
             }
 
             std::atomic_bool running(true);
-            auto loop = std::thread([&]() {
+            std::exception_ptr error;
+            auto loop = presentation_thread(running, error, [&]() {
                 sync.lock();
                 sync.unlock();
 
@@ -1724,8 +2569,9 @@ namespace hummus {
                     std::cout << "Running training instance..." << std::endl;
                 }
 
-                // loop through each .es file in the training database
-                for (auto filename : training_database) {
+                // loop through each file in the training database, after the ones a loaded checkpoint was already trained on
+                for (auto idx=first_training_file; idx<training_database.size(); ++idx) {
+                    auto& filename = training_database[idx];
                     
                     if (verbose > 1) {
                         std::cout << filename << std::endl;
@@ -1735,75 +2581,13 @@ namespace hummus {
                         break;
                     }
 
-                    auto header = sepia::read_header(sepia::filename_to_ifstream(filename));
-
                     // get the current label for the database - one label per pattern
                     if (!training_labels.empty()) {
                         current_label = training_labels[presentation_counter].id;
                     }
 
-                    double final_t = 0;
-                    if (header.event_stream_type == sepia::type::dvs) {
-
-                        sepia::join_observable<sepia::type::dvs>(
-                                                                 sepia::filename_to_ifstream(filename),
-                                                                 [&](sepia::dvs_event event) {
-                                                                     // stopping the event collection beyond a certain temporal threshold
-                                                                     if (event.t > skip_presentation || event.t > t_max || !running.load(std::memory_order_relaxed)) {
-                                                                         if (skip_presentation != std::numeric_limits<double>::max()) {
-                                                                             skip_presentation = std::numeric_limits<double>::max();
-                                                                         }
-                                                                         throw sepia::end_of_file();
-                                                                     }
-
-                                                                     // temporal crop and spatial crop and polarity selection
-                                                                     if (polarity == 2) {
-                                                                         if (event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                             final_t = static_cast<double>(event.t);
-                                                                             es_run_helper(static_cast<double>(event.t), static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min));
-                                                                         }
-                                                                     } else if (polarity == 0 || polarity == 1) {
-                                                                         if (static_cast<int>(event.is_increase) == polarity && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                             final_t = static_cast<double>(event.t);
-                                                                             es_run_helper(static_cast<double>(event.t), static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min));
-                                                                         }
-                                                                     } else {
-                                                                         throw std::logic_error("polarity is 0 for OFF events, 1 for ON events and 2 for both");
-                                                                     }
-                                                                 });
-
-                    } else if (header.event_stream_type == sepia::type::atis) {
-                        sepia::join_observable<sepia::type::atis>(
-                                                                  sepia::filename_to_ifstream(filename),
-                                                                  [&](sepia::atis_event event) {
-                                                                      // stopping the event collection beyond a certain temporal threshold
-                                                                      if (event.t > skip_presentation || event.t > t_max || !running.load(std::memory_order_relaxed)) {
-                                                                          if (skip_presentation != std::numeric_limits<double>::max()) {
-                                                                              skip_presentation = std::numeric_limits<double>::max();
-                                                                          }
-                                                                          throw sepia::end_of_file();
-                                                                      }
-
-                                                                      // filtering out gray level events, temporal crop and spatial crop and polarity selection
-                                                                      if (polarity == 2) {
-                                                                          if (!event.is_threshold_crossing && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                              final_t = static_cast<double>(event.t);
-                                                                              es_run_helper(static_cast<double>(event.t), static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min));
-                                                                          }
-                                                                      } else if (polarity == 0 || polarity == 1) {
-                                                                          if (!event.is_threshold_crossing && static_cast<int>(event.polarity) == polarity && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                              final_t = static_cast<double>(event.t);
-                                                                              es_run_helper(static_cast<double>(event.t), static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min));
-                                                                          }
-                                                                      } else {
-                                                                          throw std::logic_error("polarity is 0 for OFF events, 1 for ON events and 2 for both");
-                                                                      }
-                                                                  });
-                    } else {
-                        // throw error
-                        throw std::logic_error("unknown header type");
-                    }
-                    
+                    double final_t = present_es_events(files.next(), &running, false, t_max, x_min, y_min);
+
                     // going through any leftover spikes after the last event is propagated
                     async_run_helper(&running, false, true);
                     
@@ -1813,14 +2597,18 @@ namespace hummus {
                     }
                     
                     // send a decision spike to the computation layer of the regression neurons
-                    if (logistic_regression && decision.timer == 0 && layers[decision.layer_number].active) {
+                    if (logistic_regression && decision.timer == 0 && is_layer_active(decision.layer_number)) {
+                        touch_neuron(layers[decision.layer_number].neurons[0]);
                         neurons[layers[decision.layer_number].neurons[0]]->update(final_t, nullptr, this, 0, spike_type::decision);
                     }
                     
                     presentation_counter++;
                     
                     reset_network(false);
+
+                    save_training_checkpoint(training_database, idx+1);
                 }
+                training_position = 0;
 
                 std::chrono::duration<float> elapsed_seconds = std::chrono::system_clock::now()-start;
                 if (verbose != 0) {
@@ -1834,7 +2622,7 @@ namespace hummus {
                     
                     // can now propagate to decision-making layer if present
                     if (decision_making) {
-                        layers[decision.layer_number].active = true;
+                        activate_layer(decision.layer_number);
                         prepare_decision_making();
                     }
                     
@@ -1843,6 +2631,7 @@ namespace hummus {
                         if (verbose != 0) {
                             std::cout << "training logistic regression" << std::endl;
                         }
+                        touch_neuron(layers[decision.layer_number].neurons[0]);
                         neurons[layers[decision.layer_number].neurons[0]]->update(0, nullptr, this, 0, spike_type::none);
                     }
 
@@ -1871,72 +2660,12 @@ namespace hummus {
                             break;
                         }
 
-                        auto header = sepia::read_header(sepia::filename_to_ifstream(filename));
-
                         // get the current label for the database - one label per pattern
                         if (!test_labels.empty()) {
                             current_label = test_labels[presentation_counter].id;
                         }
-                        
-                        double final_t = 0;
-                        if (header.event_stream_type == sepia::type::dvs) {
-                            sepia::join_observable<sepia::type::dvs>(
-                                                                     sepia::filename_to_ifstream(filename),
-                                                                     [&](sepia::dvs_event event) {
-                                                                         // stopping the event collection beyond a certain temporal threshold
-                                                                         if (event.t > skip_presentation || event.t > t_max || !running.load(std::memory_order_relaxed)) {
-                                                                             if (skip_presentation != std::numeric_limits<double>::max()) {
-                                                                                 skip_presentation = std::numeric_limits<double>::max();
-                                                                             }
-                                                                             throw sepia::end_of_file();
-                                                                         }
-
-                                                                         // temporal crop and spatial crop and polarity selection
-                                                                         if (polarity == 2) {
-                                                                             if (event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                                 final_t = static_cast<double>(event.t);
-                                                                                 es_run_helper(final_t, static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min), true);
-                                                                             }
-                                                                         } else if (polarity == 0 || polarity == 1) {
-                                                                             if (static_cast<int>(event.is_increase) == polarity && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                                 final_t = static_cast<double>(event.t);
-                                                                                 es_run_helper(final_t, static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min), true);
-                                                                             }
-                                                                         } else {
-                                                                             throw std::logic_error("polarity is 0 for OFF events, 1 for ON events and 2 for both");
-                                                                         }
-                                                                     });
-                        } else if (header.event_stream_type == sepia::type::atis) {
-                            sepia::join_observable<sepia::type::atis>(
-                                                                      sepia::filename_to_ifstream(filename),
-                                                                      [&](sepia::atis_event event) {
-                                                                          // stopping the event collection beyond a certain temporal threshold
-                                                                          if (event.t > skip_presentation || event.t > t_max || !running.load(std::memory_order_relaxed)) {
-                                                                              if (skip_presentation != std::numeric_limits<double>::max()) {
-                                                                                  skip_presentation = std::numeric_limits<double>::max();
-                                                                              }
-                                                                              throw sepia::end_of_file();
-                                                                          }
-
-                                                                          // filtering out gray level events, temporal crop and spatial crop and polarity selection
-                                                                          if (polarity == 2) {
-                                                                              if (!event.is_threshold_crossing && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                                  final_t = static_cast<double>(event.t);
-                                                                                  es_run_helper(final_t, static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min), true);
-                                                                              }
-                                                                          } else if (polarity == 0 || polarity == 1) {
-                                                                              if (!event.is_threshold_crossing && static_cast<int>(event.polarity) == polarity && event.t >= t_min && event.x >= x_min && event.x <= x_max && event.y >= y_min && event.y <= y_max) {
-                                                                                  final_t = static_cast<double>(event.t);
-                                                                                  es_run_helper(final_t, static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min), true);
-                                                                              }
-                                                                          } else {
-                                                                              throw std::logic_error("polarity is 0 for OFF events, 1 for ON events and 2 for both");
-                                                                          }
-                                                                      });
-                        } else {
-                            // throw error
-                            throw std::logic_error("unknown header type");
-                        }
+
+                        double final_t = present_es_events(files.next(), &running, true, t_max, x_min, y_min);
 
                         // going through any leftover spikes after the last event is propagated
                         async_run_helper(&running, true, true);
@@ -1957,6 +2686,7 @@ namespace hummus {
 
                         // send a decision spike to the computation layer of the regression neurons
                         if (logistic_regression && decision.timer == 0) {
+                            touch_neuron(layers[decision.layer_number].neurons[0]);
                             neurons[layers[decision.layer_number].neurons[0]]->update(final_t, nullptr, this, 0, spike_type::decision);
                         }
                         
@@ -1986,9 +2716,12 @@ namespace hummus {
             }
 
             loop.join();
+            if (error) {
+                std::rethrow_exception(error);
+            }
         }
 
-        // reset the network back to the initial conditions without changing the network build
+        // reset the network back to the initial conditions without changing the network build. between presentations (clear_addons = false) only the neurons updated since the previous reset are reset, the others are still in their initial state
         void reset_network(bool clear_addons=true) {
             decision_pre_ts = 0;
             
@@ -1997,8 +2730,26 @@ namespace hummus {
                 addons.clear();
             }
             
-            for (auto& n: neurons) {
-                n->reset_neuron(this, clear_addons);
+            if (clear_addons || full_reset_pending) {
+                for (auto& n: neurons) {
+                    n->reset_neuron(this, clear_addons);
+                }
+                full_reset_pending = false;
+            } else {
+                for (auto idx: touched_neurons) {
+                    neurons[idx]->reset_neuron(this, false);
+                }
+            }
+            touched_neurons.clear();
+
+            // a neuron stamped before the epoch counter wrapped around could be missed, so the next reset goes through every neuron
+            if (++presentation_epoch == 0) {
+                presentation_epoch = 1;
+                full_reset_pending = true;
+            }
+
+            for (auto& inhibition: lateral_inhibitions) {
+                inhibition->reset();
             }
 
             if (th_addon) {
@@ -2006,6 +2757,425 @@ namespace hummus {
             }
         }
 
+        // renumbers the neurons inside each sublayer so that neurons exchanging spikes sit next to each other in memory, then moves the neuron storage and updates the synapses, receptive fields and addon masks accordingly. meant to be called once the network is built and before it runs. neuron_ordering::cuthill_mckee follows the synaptic graph while neuron_ordering::spatial_tiling stores 2D layers by tiles of tile_size x tile_size neurons. inject_spike, inject_input and the loggers keep using the ids given at construction (see get_neuron_index and get_user_id)
+        void reorder_neurons(neuron_ordering ordering=neuron_ordering::cuthill_mckee, int tile_size=4) {
+            if (tile_size <= 0) {
+                throw std::logic_error("the tile size has to be strictly positive");
+            }
+
+            // position of every neuron in the new global order
+            std::vector<std::size_t> rank;
+            if (ordering == neuron_ordering::cuthill_mckee) {
+                rank = cuthill_mckee_rank();
+            } else {
+                rank = spatial_tiling_rank(tile_size);
+            }
+
+            // every layer is checked before any of them is permuted, so a layer that cannot be reordered leaves the network untouched
+            for (auto& l: layers) {
+                if (l.neurons.empty()) {
+                    continue;
+                }
+
+                auto& pool = neuron_pools[l.id];
+                if (pool->size() != l.neurons.size()) {
+                    throw std::logic_error("the neurons of a layer are not stored contiguously and cannot be reordered");
+                }
+                if (!pool->can_permute()) {
+                    throw std::logic_error("this neuron type cannot be moved in memory so its layer cannot be reordered");
+                }
+            }
+
+            // sorting each sublayer by rank. layers and sublayers keep their index ranges so only neurons within a sublayer are swapped
+            std::vector<std::size_t> new_indices(neurons.size());
+            for (auto& l: layers) {
+                if (l.neurons.empty()) {
+                    continue;
+                }
+
+                auto& pool = neuron_pools[l.id];
+                std::size_t layer_begin = l.neurons.front();
+                std::vector<std::size_t> order;
+                order.reserve(l.neurons.size());
+                for (auto& sub: l.sublayers) {
+                    std::vector<std::size_t> sorted_neurons(sub.neurons.begin(), sub.neurons.end());
+                    std::stable_sort(sorted_neurons.begin(), sorted_neurons.end(), [&](std::size_t a, std::size_t b) {
+                        return rank[a] < rank[b];
+                    });
+
+                    for (std::size_t i=0; i<sorted_neurons.size(); ++i) {
+                        new_indices[sorted_neurons[i]] = sub.neurons[i];
+                        order.emplace_back(sorted_neurons[i] - layer_begin);
+                    }
+                }
+
+                pool->permute(order);
+                for (std::size_t i=0; i<order.size(); ++i) {
+                    neurons[layer_begin + i] = pool->at(i);
+                }
+            }
+
+            // relabelling the neurons and their synapses
+            for (std::size_t i=0; i<neurons.size(); ++i) {
+                auto& n = neurons[i];
+                n->set_neuron_id(static_cast<int>(i));
+
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    axon_terminal->set_presynaptic_neuron_id(static_cast<int>(i));
+                    axon_terminal->set_postsynaptic_neuron_id(static_cast<int>(new_indices[axon_terminal->get_postsynaptic_neuron_id()]));
+                }
+
+                if (n->get_initial_synapse()) {
+                    n->get_initial_synapse()->set_postsynaptic_neuron_id(static_cast<int>(i));
+                }
+            }
+
+            for (auto& l: layers) {
+                for (auto& sub: l.sublayers) {
+                    for (auto& rf: sub.receptive_fields) {
+                        for (auto& n: rf.neurons) {
+                            n = new_indices[n];
+                        }
+                    }
+                }
+            }
+
+            for (auto& addon: addons) {
+                addon->relabel_neurons(new_indices);
+            }
+
+            if (th_addon) {
+                th_addon->relabel_neurons(new_indices);
+            }
+
+            for (auto& projection: projections) {
+                projection->relabel_neurons(new_indices);
+            }
+
+            for (auto& inhibition: lateral_inhibitions) {
+                inhibition->relabel_neurons(new_indices);
+            }
+
+            for (auto& idx: touched_neurons) {
+                idx = new_indices[idx];
+            }
+
+            // keeping track of the ids given at construction
+            if (user_ids.empty()) {
+                user_ids.resize(neurons.size());
+                std::iota(user_ids.begin(), user_ids.end(), 0);
+            }
+
+            std::vector<std::size_t> reordered_user_ids(neurons.size());
+            for (std::size_t old_idx=0; old_idx<neurons.size(); ++old_idx) {
+                reordered_user_ids[new_indices[old_idx]] = user_ids[old_idx];
+            }
+            user_ids = std::move(reordered_user_ids);
+
+            neuron_indices.resize(neurons.size());
+            for (std::size_t idx=0; idx<neurons.size(); ++idx) {
+                neuron_indices[user_ids[idx]] = idx;
+            }
+        }
+
+        // removes the synapses whose absolute weight is below threshold, typically between training and testing so the test phase does not deliver spikes through them. layer_id restricts the pruning to the synapses reaching one layer (-1 for every layer). the ports of projections are never pruned. returns the number of synapses removed
+        std::size_t prune_synapses(float threshold, int layer_id=-1) {
+            return remove_synapses(layer_id, [&](std::vector<Synapse*>::iterator first, std::vector<Synapse*>::iterator last) {
+                return std::stable_partition(first, last, [&](Synapse* synapse) {
+                    return std::abs(synapse->get_weight()) >= threshold;
+                });
+            });
+        }
+
+        // keeps the k synapses with the highest absolute weight reaching each neuron and removes the others. same scope as prune_synapses
+        std::size_t keep_strongest_synapses(std::size_t k, int layer_id=-1) {
+            return remove_synapses(layer_id, [&](std::vector<Synapse*>::iterator first, std::vector<Synapse*>::iterator last) {
+                if (static_cast<std::size_t>(last - first) <= k) {
+                    return last;
+                }
+                std::nth_element(first, first + static_cast<std::ptrdiff_t>(k), last, [](Synapse* a, Synapse* b) {
+                    return std::abs(a->get_weight()) > std::abs(b->get_weight());
+                });
+                return first + static_cast<std::ptrdiff_t>(k);
+            });
+        }
+
+        // walks the network and returns how many bytes each component uses. only reads sizes and capacities so it can be called at any point, including from an addon during a run
+        memory_report memory_footprint() const {
+            memory_report report;
+
+            // neurons and the containers they own
+            for (auto& pool: neuron_pools) {
+                report.neurons.add(pool->size(), pool->get_memory_footprint(), pool->is_heap_allocated() ? 1 : 0);
+            }
+
+            const char* previous_model = nullptr;
+            memory_usage* model_usage = nullptr;
+            std::size_t pooled_synapse_bytes = 0;
+            for (auto& n: neurons) {
+                auto& dendritic_tree = n->get_dendritic_tree();
+                auto& axon_terminals = n->get_axon_terminals();
+                auto& relevant_addons = n->get_relevant_addons();
+                auto hooked_addons_bytes = n->get_hooked_addons().get_memory_footprint();
+                report.neuron_containers.add(1,
+                                             dendritic_tree.capacity() * sizeof(Synapse*) + axon_terminals.capacity() * sizeof(std::unique_ptr<Synapse>) + relevant_addons.capacity() * sizeof(Addon*) + hooked_addons_bytes,
+                                             (dendritic_tree.capacity() > 0) + (axon_terminals.capacity() > 0) + (relevant_addons.capacity() > 0) + (hooked_addons_bytes > 0));
+
+                // synapses are either carved from the arena of their neuron pool or separate heap blocks, and may carry their own random engine. the model lookup is cached because consecutive synapses almost always share a model
+                auto add_synapse = [&](const Synapse* synapse) {
+                    const char* model = synapse->get_model_name();
+                    if (model != previous_model) {
+                        previous_model = model;
+                        model_usage = &report.synapses[model];
+                    }
+                    auto rng_bytes = synapse->get_random_engine_footprint();
+                    bool pooled = synapse_arena::owner(synapse) != nullptr;
+                    if (pooled) {
+                        pooled_synapse_bytes += synapse->get_memory_footprint();
+                    }
+                    model_usage->add(1, synapse->get_memory_footprint() - rng_bytes, pooled ? 0 : 1);
+                    if (rng_bytes > 0) {
+                        report.random_engines.add(1, rng_bytes);
+                    }
+                };
+
+                for (auto& axon_terminal: axon_terminals) {
+                    add_synapse(axon_terminal.get());
+                }
+                if (n->get_initial_synapse()) {
+                    add_synapse(n->get_initial_synapse().get());
+                }
+            }
+
+            // the pooled synapses are already counted above, so only the rest of the arena chunks is added
+            for (auto& pool: neuron_pools) {
+                auto& arena = pool->get_synapse_arena();
+                report.synapse_pools.add(0, arena.get_memory_footprint(), arena.get_heap_blocks());
+            }
+            report.synapse_pools.bytes -= std::min(pooled_synapse_bytes, report.synapse_pools.bytes);
+
+            // pending spikes. the standard containers don't expose the capacity of the priority queue, so its current size is used
+            report.spike_queue.add(spike_queue.size(), spike_queue.size() * sizeof(spike), spike_queue.empty() ? 0 : 1);
+            report.predicted_spikes.add(predicted_spikes.size(), predicted_spikes.size() * sizeof(spike), predicted_spikes.empty() ? 0 : 1);
+
+            // network structure
+            report.layers.add(layers.size(), layers.capacity() * sizeof(layer), layers.capacity() > 0);
+            for (auto& l: layers) {
+                report.layers.add(l.sublayers.size(), l.sublayers.capacity() * sizeof(sublayer), l.sublayers.capacity() > 0);
+                for (auto& sub: l.sublayers) {
+                    report.layers.add(sub.receptive_fields.size(), sub.receptive_fields.capacity() * sizeof(receptive_field), sub.receptive_fields.capacity() > 0);
+                    for (auto& rf: sub.receptive_fields) {
+                        report.layers.add(0, rf.neurons.capacity() * sizeof(std::size_t), rf.neurons.capacity() > 0);
+                    }
+                }
+            }
+
+            for (auto& addon: addons) {
+                report.addons.add(1, addon->get_memory_footprint(), 1);
+            }
+            if (th_addon) {
+                report.addons.add(1, th_addon->get_memory_footprint(), 1);
+            }
+
+            for (auto& projection: projections) {
+                report.projections.add(1, projection->get_memory_footprint(), 1 + projection->get_number_of_ports());
+            }
+            for (auto& inhibition: lateral_inhibitions) {
+                report.projections.add(1, inhibition->get_memory_footprint(), inhibition->get_heap_blocks());
+            }
+
+            report.random_engines.add(1, sizeof(random_engine));
+
+            report.bookkeeping.add(neurons.size(), neurons.capacity() * sizeof(neuron_handle) + neuron_pools.capacity() * sizeof(std::unique_ptr<neuron_pool>), 2);
+            report.bookkeeping.add(0, decision_labels.get_memory_footprint(), 3);
+            report.bookkeeping.add(training_labels.size() + test_labels.size(), (training_labels.size() + test_labels.size()) * sizeof(label), 2);
+            report.bookkeeping.add(0, (user_ids.capacity() + neuron_indices.capacity()) * sizeof(std::size_t), (user_ids.capacity() > 0) + (neuron_indices.capacity() > 0));
+
+            return report;
+        }
+
+        // saves the layers, neurons, synapses and decision-making state of the network in a versioned binary file read back by load_checkpoint. addons are not saved and have to be created again. networks with implicit projections or lateral inhibitions cannot be saved yet
+        void save_checkpoint(const std::string& filename) {
+            check_checkpointable();
+
+            checkpoint_writer writer;
+
+            state_archive network_state;
+            serialise_network_state(network_state);
+            writer.add_section("network", std::move(network_state.get_buffer()));
+
+            state_archive structure;
+            serialise_layers(structure);
+            writer.add_section("layers", std::move(structure.get_buffer()));
+
+            // neurons pool by pool, which is the order of the neurons vector
+            state_archive neuron_state;
+            std::uint64_t pool_count = neuron_pools.size();
+            neuron_state(pool_count);
+            for (auto& pool: neuron_pools) {
+                std::string model = pool->get_model_name();
+                std::uint64_t count = pool->size();
+                neuron_state(model, count);
+                for (std::size_t i=0; i<pool->size(); ++i) {
+                    pool->at(i)->serialise(neuron_state);
+                }
+            }
+            writer.add_section("neurons", std::move(neuron_state.get_buffer()));
+
+            // axon terminals neuron by neuron, then the dendritic trees as positions in that list
+            state_archive synapse_state;
+            std::vector<std::string> models;
+            std::unordered_map<const Synapse*, std::uint64_t> synapse_indices;
+            for (auto& n: neurons) {
+                std::uint64_t count = n->get_axon_terminals().size();
+                synapse_state(count);
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    std::string name = axon_terminal->get_model_name();
+                    auto model = static_cast<std::uint16_t>(std::find(models.begin(), models.end(), name) - models.begin());
+                    if (model == models.size()) {
+                        models.emplace_back(name);
+                    }
+                    synapse_state(model);
+                    axon_terminal->serialise(synapse_state);
+                    synapse_indices.emplace(axon_terminal.get(), synapse_indices.size());
+                }
+            }
+
+            state_archive model_table;
+            model_table(models);
+            writer.add_section("synapse_models", std::move(model_table.get_buffer()));
+            writer.add_section("synapses", std::move(synapse_state.get_buffer()));
+
+            state_archive dendrite_state;
+            std::vector<std::uint64_t> indices;
+            for (auto& n: neurons) {
+                indices.clear();
+                for (auto dendrite: n->get_dendritic_tree()) {
+                    auto it = synapse_indices.find(dendrite);
+                    if (it == synapse_indices.end()) {
+                        throw std::logic_error("a dendritic tree holds a synapse that is not the axon terminal of a neuron and cannot be saved");
+                    }
+                    indices.emplace_back(it->second);
+                }
+                dendrite_state(indices);
+            }
+            writer.add_section("dendrites", std::move(dendrite_state.get_buffer()));
+
+            state_archive training_state;
+            training_state(training_position, next_training_file);
+            writer.add_section("training", std::move(training_state.get_buffer()));
+
+            writer.save(filename);
+        }
+
+        // rebuilds a network saved with save_checkpoint inside an empty network. Ts are the neuron models of the saved layers (for example load_checkpoint<hummus::Parrot, hummus::CUBA_LIF>), the synapse models being the ones of the synapses folder. the file is memory-mapped and nothing from the construction is replayed, so the network is ready as soon as the neurons and synapses are allocated
+        template <typename... Ts>
+        void load_checkpoint(const std::string& filename) {
+            static_assert(sizeof...(Ts) > 0, "give load_checkpoint the neuron models used by the saved network");
+
+            if (!neurons.empty() || !layers.empty()) {
+                throw std::logic_error("a checkpoint can only be loaded into an empty network");
+            }
+
+            checkpoint_reader reader(filename);
+
+            auto network_state = reader.section("network");
+            serialise_network_state(network_state);
+
+            // the loaded neurons are not in their initial state if the checkpoint was saved during a presentation
+            full_reset_pending = true;
+
+            auto structure = reader.section("layers");
+            serialise_layers(structure);
+            for (auto& l: layers) {
+                active_layers.push_back(l.active);
+            }
+
+            auto neuron_state = reader.section("neurons");
+            std::uint64_t pool_count = 0;
+            neuron_state(pool_count);
+            for (std::uint64_t p=0; p<pool_count; ++p) {
+                std::string model;
+                std::uint64_t count = 0;
+                neuron_state(model, count);
+
+                // an empty pool only keeps the pools aligned with the layers, so its type does not matter
+                bool known = ((model == Ts::model_name() && (load_neuron_pool<Ts>(neuron_state, count), true)) || ...);
+                if (!known && count == 0) {
+                    load_neuron_pool<std::tuple_element_t<0, std::tuple<Ts...>>>(neuron_state, 0);
+                } else if (!known) {
+                    throw std::logic_error("the neuron model " + model + " is not among the models given to load_checkpoint");
+                }
+            }
+
+            for (auto& l: layers) {
+                if (l.neurons.last > neurons.size()) {
+                    throw std::logic_error("the checkpoint is truncated or corrupted");
+                }
+            }
+
+            auto model_table = reader.section("synapse_models");
+            std::vector<std::string> models;
+            model_table(models);
+
+            auto synapse_state = reader.section("synapses");
+            std::vector<Synapse*> synapses;
+            for (auto& n: neurons) {
+                std::uint64_t count = 0;
+                synapse_state(count);
+                auto& axon_terminals = n->get_axon_terminals();
+                axon_terminals.reserve(count);
+                for (std::uint64_t i=0; i<count; ++i) {
+                    std::uint16_t model = 0;
+                    synapse_state(model);
+                    if (model >= models.size()) {
+                        throw std::logic_error("the checkpoint is truncated or corrupted");
+                    }
+                    axon_terminals.emplace_back(make_checkpoint_synapse(models[model], n->get_synapse_arena()));
+                    axon_terminals.back()->serialise(synapse_state);
+                    synapses.emplace_back(axon_terminals.back().get());
+                }
+            }
+
+            auto dendrite_state = reader.section("dendrites");
+            std::vector<std::uint64_t> indices;
+            for (auto& n: neurons) {
+                dendrite_state(indices);
+                auto& dendritic_tree = n->get_dendritic_tree();
+                dendritic_tree.reserve(indices.size());
+                for (auto idx: indices) {
+                    if (idx >= synapses.size()) {
+                        throw std::logic_error("the checkpoint is truncated or corrupted");
+                    }
+                    dendritic_tree.emplace_back(synapses[idx]);
+                }
+            }
+
+            // position in the training database of the run that saved the checkpoint
+            if (reader.has_section("training")) {
+                auto training_state = reader.section("training");
+                training_state(training_position, next_training_file);
+            }
+        }
+
+        // saves a checkpoint to filename (see save_checkpoint) every interval training presentations of run_es_database and run_npy_database, and once the training database is over. a network loaded from that checkpoint and given the same databases skips the files it was already trained on. the addons are not part of the checkpoint and have to be created again before resuming. the runs throw before starting if the network cannot be saved
+        void set_training_checkpoints(const std::string& filename, int interval) {
+            if (interval <= 0) {
+                throw std::logic_error("the checkpoint interval has to be strictly positive");
+            }
+            checkpoint_filename = filename;
+            checkpoint_interval = interval;
+        }
+
+        // run_es_database and run_npy_database read and decode the next depth files of the database on background threads while the current one is presented. each file loaded ahead is held in memory until it is presented
+        void set_prefetching(std::size_t depth, std::size_t threads=1) {
+            if (depth == 0 || threads == 0) {
+                throw std::logic_error("at least one file has to be loaded ahead by at least one thread");
+            }
+            prefetch_depth = depth;
+            prefetch_threads = threads;
+        }
+
         // initialises an addon that needs to run on the main thread
         template <typename T, typename... Args>
         T& make_gui(Args&&... args) {
@@ -2020,12 +3190,147 @@ namespace hummus {
             return static_cast<T&>(*addons.back());
         }
 
+        // initialises a projection between two layers (see the projections folder). returns a reference to the projection
+        template <typename T, typename... Args>
+        T& make_projection(Args&&... args) {
+            projections.emplace_back(new T(*this, std::forward<Args>(args)...));
+            auto& projection = *projections.back();
+
+            auto layer_id = static_cast<std::size_t>(projection.get_presynaptic_layer_id());
+            if (outgoing_projections.size() <= layer_id) {
+                outgoing_projections.resize(layer_id + 1);
+            }
+            outgoing_projections[layer_id].emplace_back(&projection);
+
+            // to shift the network runtime by the maximum delay in the clock mode
+            max_delay = std::max(max_delay, projection.get_max_delay());
+            return static_cast<T&>(projection);
+        }
+
+        // sends the spikes of a neuron that fired through the projections leaving its layer and its implicit lateral inhibition
+        void propagate_projections(double timestamp, const Neuron* neuron) {
+            if (auto inhibition = neuron->get_lateral_inhibition()) {
+                inhibition->neuron_fired(neuron->get_neuron_id(), timestamp);
+            }
+
+            auto layer_id = static_cast<std::size_t>(neuron->get_layer_id());
+            if (layer_id < outgoing_projections.size()) {
+                for (auto projection: outgoing_projections[layer_id]) {
+                    if (is_layer_active(projection->get_postsynaptic_layer_id())) {
+                        projection->propagate(timestamp, neuron->get_neuron_id());
+                    }
+                }
+            }
+        }
+
+        // lists a neuron for the next reset_network(false). the event loops call it before every update, and code changing the state of a neuron that is not being updated calls it too
+        void touch_neuron(std::size_t idx) {
+            if (neurons[idx]->mark_for_reset(presentation_epoch)) {
+                touched_neurons.emplace_back(idx);
+            }
+        }
+
         // ----- SETTERS AND GETTERS -----
 
-        std::vector<std::unique_ptr<Neuron>>& get_neurons() {
+        std::vector<neuron_handle>& get_neurons() {
             return neurons;
         }
 
+        // the layer connection methods called afterwards draw the weights and delays of each connection from a counter-based stream keyed on (seed, presynaptic neuron, postsynaptic neuron, synapse index) instead of the shared random engine. the network is then identical for a given seed and order of calls, whatever the number of threads used to build it (0 uses every hardware thread)
+        void set_construction_seed(std::uint64_t seed, unsigned threads=0) {
+            seeded_construction = true;
+            construction_seed = seed;
+            construction_threads = threads;
+            construction_calls = 0;
+        }
+
+        bool is_construction_seeded() const {
+            return seeded_construction;
+        }
+
+        std::uint64_t get_construction_seed() const {
+            return construction_seed;
+        }
+
+        // engine the layer connection methods and the projections draw from when no construction seed is set
+        std::mt19937& get_random_engine() {
+            return random_engine;
+        }
+
+        // splits [0, size) into one contiguous chunk per construction thread. small workloads stay on the calling thread. also used by the projections that enumerate their connections
+        template <typename F>
+        void parallel_for(std::size_t size, F&& chunk) {
+            std::size_t thread_count = construction_threads > 0 ? construction_threads : std::max(std::thread::hardware_concurrency(), 1u);
+            thread_count = std::min(thread_count, std::max<std::size_t>(size / 4096, 1));
+
+            if (thread_count == 1) {
+                chunk(0, size);
+                return;
+            }
+
+            std::vector<std::exception_ptr> errors(thread_count);
+            std::vector<std::thread> workers;
+            for (std::size_t t=1; t<thread_count; ++t) {
+                workers.emplace_back([&, t]() {
+                    try {
+                        chunk(t * size / thread_count, (t+1) * size / thread_count);
+                    } catch (...) {
+                        errors[t] = std::current_exception();
+                    }
+                });
+            }
+
+            try {
+                chunk(0, size / thread_count);
+            } catch (...) {
+                errors[0] = std::current_exception();
+            }
+
+            for (auto& worker: workers) {
+                worker.join();
+            }
+
+            for (auto& error: errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+
+        // whether the layer connection methods keep exactly connection_ratio % of the connections or each connection with a probability of connection_ratio %
+        void set_connection_sampling(connection_sampling new_sampling) {
+            sampling = new_sampling;
+        }
+
+        connection_sampling get_connection_sampling() const {
+            return sampling;
+        }
+
+        // page size and NUMA placement of the neurons of the layers created afterwards and of the synapses leaving them
+        void set_memory_policy(memory_policy new_policy) {
+            neuron_memory_policy = new_policy;
+        }
+
+        memory_policy get_memory_policy() const {
+            return neuron_memory_policy;
+        }
+
+        // index in the neurons vector of the neuron that was created with user_id. both only differ after reorder_neurons
+        int get_neuron_index(int user_id) const {
+            if (neuron_indices.empty() || user_id < 0) {
+                return user_id;
+            }
+            return static_cast<int>(neuron_indices[user_id]);
+        }
+
+        // id given at construction to the neuron stored at neuron_idx
+        int get_user_id(int neuron_idx) const {
+            if (user_ids.empty() || neuron_idx < 0) {
+                return neuron_idx;
+            }
+            return static_cast<int>(user_ids[neuron_idx]);
+        }
+
         std::vector<layer>& get_layers() {
             return layers;
         }
@@ -2086,16 +3391,27 @@ namespace hummus {
             return decision;
         }
 
+        decision_history& get_decision_history() {
+            return decision_labels;
+        }
+
         int get_presentation_counter() const {
             return presentation_counter;
         }
         
+        // layers have to be toggled through these methods so the active-layer mask used by the firing path stays in sync
         void activate_layer(int layer_id) {
             layers[layer_id].active = true;
+            active_layers[layer_id] = true;
         }
         
         void deactivate_layer(int layer_id) {
             layers[layer_id].active = false;
+            active_layers[layer_id] = false;
+        }
+
+        bool is_layer_active(int layer_id) const {
+            return active_layers[layer_id];
         }
         
         // verbose argument (0 for no couts at all, 1 for network-related print-outs and learning rule print-outs, 2 for network and neuron-related print-outs
@@ -2111,10 +3427,576 @@ namespace hummus {
 
         // -----PROTECTED NETWORK METHODS -----
 
-        void es_run_helper(double t, int x, int y, int x_min, int y_min, bool classification=false) {
+        // appends a layer and its entry in the active-layer mask
+        layer& add_layer(layer new_layer) {
+            active_layers.push_back(new_layer.active);
+            layers.emplace_back(std::move(new_layer));
+            return layers.back();
+        }
+
+        // gives every call to a layer connection method its own key so two projections between the same neurons don't share streams
+        void begin_projection() {
+            if (seeded_construction) {
+                projection_key = philox_engine::mix(construction_seed ^ philox_engine::mix(construction_calls++));
+                selection_draws = 0;
+            }
+        }
+
+        // random stream of one synapse of the current projection. neurons are identified by their user id so the streams survive reorder_neurons
+        philox_engine connection_stream(std::size_t pre, std::size_t post, std::uint32_t synapse) const {
+            return philox_engine(projection_key, static_cast<std::uint32_t>(get_user_id(static_cast<int>(pre))), static_cast<std::uint32_t>(get_user_id(static_cast<int>(post))), synapse);
+        }
+
+        // creates the synapses recorded by a layer connection method. shape post-processes the weight and delay drawn from lambdaFunction. without a construction seed the synapses are created one by one from the shared random engine, otherwise the draws and the synapse allocations are spread across threads
+        template <typename T, typename F, typename S, typename... Args>
+        void build_connections(const std::vector<planned_connection>& plan, F& lambdaFunction, S&& shape, bool track_delay, Args&&... args) {
+            if (!seeded_construction) {
+                for (auto& c: plan) {
+                    const std::pair<float, float> weight_delay = shape(std::pair<float, float>(lambdaFunction(c.x, c.y, c.depth, random_engine)));
+                    if (c.forward) {
+                        neurons[c.pre]->make_synapse<T>(neurons[c.post].get(), weight_delay.first, weight_delay.second, args...);
+                    }
+                    if (c.backward) {
+                        neurons[c.post]->make_synapse<T>(neurons[c.pre].get(), weight_delay.first, weight_delay.second, args...);
+                    }
+
+                    // to shift the network runtime by the maximum delay in the clock mode
+                    if (track_delay) {
+                        max_delay = std::max(max_delay, weight_delay.second);
+                    }
+                }
+                return;
+            }
+
+            // drawing weights and delays. each connection uses a fresh copy of the distribution so nothing carries over between streams
+            std::vector<std::pair<float, float>> weight_delays(plan.size());
+            parallel_for(plan.size(), [&](std::size_t first, std::size_t last) {
+                for (auto k=first; k<last; ++k) {
+                    auto& c = plan[k];
+                    auto distribution = lambdaFunction;
+                    auto stream = connection_stream(c.pre, c.post, c.synapse);
+                    weight_delays[k] = shape(std::pair<float, float>(distribution(c.x, c.y, c.depth, stream)));
+                }
+            });
+
+            if (track_delay) {
+                for (auto& weight_delay: weight_delays) {
+                    max_delay = std::max(max_delay, weight_delay.second);
+                }
+            }
+
+            // one entry per synapse, in the order the serial construction creates them
+            struct planned_synapse {
+                std::size_t from;
+                std::size_t to;
+                std::size_t connection;
+                Synapse*    synapse;
+            };
+
+            std::vector<planned_synapse> synapses;
+            synapses.reserve(plan.size());
+            for (std::size_t k=0; k<plan.size(); ++k) {
+                if (plan[k].forward) {
+                    synapses.emplace_back(planned_synapse{plan[k].pre, plan[k].post, k, nullptr});
+                }
+                if (plan[k].backward) {
+                    synapses.emplace_back(planned_synapse{plan[k].post, plan[k].pre, k, nullptr});
+                }
+            }
+
+            // stable counting sort of the synapses by neuron, so each neuron's synapses end up contiguous and in serial order
+            auto group_by = [&](auto neuron_of) {
+                std::vector<std::size_t> offsets(neurons.size() + 1, 0);
+                for (auto& s: synapses) {
+                    ++offsets[neuron_of(s) + 1];
+                }
+                std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+                std::vector<std::size_t> order(synapses.size());
+                for (std::size_t k=0; k<synapses.size(); ++k) {
+                    order[offsets[neuron_of(synapses[k])]++] = k;
+                }
+                return order;
+            };
+
+            // every thread gets a chunk of the sorted synapses, moved to neuron boundaries so a neuron's vectors are only touched by one thread
+            auto for_each_neuron_chunk = [&](const std::vector<std::size_t>& order, auto neuron_of, auto&& create) {
+                parallel_for(order.size(), [&](std::size_t first, std::size_t last) {
+                    auto aligned = [&](std::size_t k) {
+                        while (k > 0 && k < order.size() && neuron_of(synapses[order[k]]) == neuron_of(synapses[order[k-1]])) {
+                            ++k;
+                        }
+                        return k;
+                    };
+                    for (auto k=aligned(first); k<aligned(last); ++k) {
+                        create(synapses[order[k]]);
+                    }
+                });
+            };
+
+            // axon terminals, grouped by presynaptic neuron
+            auto from = [](const planned_synapse& s) { return s.from; };
+            for_each_neuron_chunk(group_by(from), from, [&](planned_synapse& s) {
+                auto& weight_delay = weight_delays[s.connection];
+                s.synapse = neurons[s.from]->template make_axon_terminal<T>(neurons[s.to].get(), weight_delay.first, weight_delay.second, args...);
+            });
+
+            // dendritic trees, grouped by postsynaptic neuron
+            auto to = [](const planned_synapse& s) { return s.to; };
+            for_each_neuron_chunk(group_by(to), to, [&](planned_synapse& s) {
+                neurons[s.to]->get_dendritic_tree().emplace_back(s.synapse);
+            });
+        }
+
+        // allocates contiguous storage for the neurons of a new layer
+        template <typename T>
+        typed_neuron_pool<T>& make_neuron_pool(std::size_t size) {
+            neuron_pools.emplace_back(std::make_unique<typed_neuron_pool<T>>(size, neuron_memory_policy));
+            // one reallocation for the whole layer at most, growing geometrically so that building many small layers stays linear
+            if (neurons.size() + size > neurons.capacity()) {
+                neurons.reserve(std::max(neurons.size() + size, 2 * neurons.capacity()));
+            }
+            return static_cast<typed_neuron_pool<T>&>(*neuron_pools.back());
+        }
+
+        // first file of a training database run: the one following the files a loaded checkpoint was trained on, 0 otherwise
+        std::size_t resume_training(const std::vector<std::string>& training_database) {
+            if (training_position == 0) {
+                return 0;
+            }
+
+            if (training_position > training_database.size() || (training_position < training_database.size() && training_database[training_position] != next_training_file)) {
+                throw std::logic_error("the training database does not match the one the checkpoint was saved from");
+            }
+
+            if (verbose != 0) {
+                std::cout << "resuming the training after " << training_position << " files" << std::endl;
+            }
+            return training_position;
+        }
+
+        // throws if save_checkpoint would refuse the network. called before the database runs that save checkpoints, on the thread of the caller
+        void check_checkpointable() const {
+            if (!projections.empty() || !lateral_inhibitions.empty()) {
+                throw std::logic_error("networks with implicit projections or lateral inhibitions cannot be saved to a checkpoint");
+            }
+
+            for (auto& pool: neuron_pools) {
+                if (pool->size() > 0 && pool->get_model_name() == Neuron::model_name()) {
+                    throw std::logic_error("the neurons of layer " + std::to_string(pool->at(0)->get_layer_id()) + " cannot be saved, their model needs a model_name and a serialise method");
+                }
+            }
+        }
+
+        // runs the presentations of a run method on their own thread. an exception thrown there stops the run and is kept in error, for the caller to rethrow once the thread is joined
+        template <typename F>
+        std::thread presentation_thread(std::atomic_bool& running, std::exception_ptr& error, F&& presentations) {
+            return std::thread([&running, &error, presentations = std::forward<F>(presentations)]() mutable {
+                try {
+                    presentations();
+                } catch (...) {
+                    error = std::current_exception();
+                    running.store(false, std::memory_order_relaxed);
+                }
+            });
+        }
+
+        // called once the network is reset after a training presentation. saves the periodic checkpoint set with set_training_checkpoints
+        void save_training_checkpoint(const std::vector<std::string>& training_database, std::size_t presented_files) {
+            training_position = presented_files;
+            next_training_file = presented_files < training_database.size() ? training_database[presented_files] : std::string();
+            if (checkpoint_interval > 0 && (presented_files % checkpoint_interval == 0 || presented_files == training_database.size())) {
+                if (verbose != 0) {
+                    std::cout << "saving a checkpoint after " << presented_files << " files" << std::endl;
+                }
+                save_checkpoint(checkpoint_filename);
+            }
+        }
+
+        // neurons of one pool read from a checkpoint
+        template <typename T>
+        void load_neuron_pool(state_archive& archive, std::size_t count) {
+            auto& pool = make_neuron_pool<T>(count);
+            for (std::size_t i=0; i<count; ++i) {
+                auto neuron = pool.emplace(0, 0, 0, 0, std::pair(-1, -1));
+                neuron->serialise(archive);
+                neurons.emplace_back(neuron);
+            }
+        }
+
+        // synapse of a saved model allocated from the arena of its neuron pool, given its parameters by Synapse::serialise
+        static std::unique_ptr<Synapse> make_checkpoint_synapse(const std::string& model, synapse_arena* arena) {
+            if (model == "Exponential") {
+                return std::unique_ptr<Synapse>(new (arena) Exponential(0, 0, 0, 0));
+            } else if (model == "Square") {
+                return std::unique_ptr<Synapse>(new (arena) Square(0, 0, 0, 0));
+            } else if (model == "Memristor") {
+                return std::unique_ptr<Synapse>(new (arena) Memristor(0, 0, 0, 0));
+            } else if (model == "Synapse") {
+                return std::unique_ptr<Synapse>(new (arena) Synapse(0, 0, 0, 0));
+            }
+            throw std::logic_error("the synapse model " + model + " cannot be loaded from a checkpoint");
+        }
+
+        // layers, sublayers and receptive fields, in both directions
+        void serialise_layers(state_archive& archive) {
+            std::uint64_t layer_count = layers.size();
+            archive(layer_count);
+            if (archive.is_loading()) {
+                layers.resize(layer_count);
+            }
+
+            for (auto& l: layers) {
+                std::uint64_t sublayer_count = l.sublayers.size();
+                archive(l.id, l.active, l.width, l.height, l.kernel_size, l.stride, l.neurons, sublayer_count);
+                if (archive.is_loading()) {
+                    l.sublayers.resize(sublayer_count);
+                }
+
+                for (auto& sub: l.sublayers) {
+                    std::uint64_t rf_count = sub.receptive_fields.size();
+                    archive(sub.id, sub.neurons, rf_count);
+                    if (archive.is_loading()) {
+                        sub.receptive_fields.resize(rf_count);
+                    }
+
+                    for (auto& rf: sub.receptive_fields) {
+                        archive(rf.id, rf.neurons);
+                    }
+                }
+            }
+        }
+
+        // decision-making parameters, labels, counters, id mappings and the state of the random engine, in both directions
+        void serialise_network_state(state_archive& archive) {
+            std::vector<std::pair<int, int>> classes(classes_map.begin(), classes_map.end());
+            std::string engine_state;
+            if (!archive.is_loading()) {
+                std::ostringstream stream;
+                stream << random_engine;
+                engine_state = stream.str();
+            }
+
+            archive(decision, decision_making, logistic_regression, learning_status, learning_off_signal, max_delay, skip_presentation, presentation_counter, current_label, classes, training_labels, test_labels, user_ids, neuron_indices, engine_state);
+            decision_labels.serialise(archive);
+
+            if (archive.is_loading()) {
+                classes_map = std::unordered_map<int, int>(classes.begin(), classes.end());
+                std::istringstream stream(engine_state);
+                stream >> random_engine;
+            }
+        }
+
+        // shared by prune_synapses and keep_strongest_synapses. select moves the synapses to keep to the front of the synapses reaching one neuron and returns the end of them. the others are erased from the dendritic tree and the axon terminals holding them, which keep their order and release their spare capacity
+        template <typename F>
+        std::size_t remove_synapses(int layer_id, F&& select) {
+            // error handling
+            if (!spike_queue.empty() || !predicted_spikes.empty()) {
+                throw std::logic_error("synapses cannot be pruned while spikes are still pending");
+            }
+
+            if (layer_id >= static_cast<int>(layers.size())) {
+                throw std::logic_error("the layer to prune does not exist");
+            }
+
+            // grouping the synapses owned by the neurons by postsynaptic neuron, in compressed form
+            auto in_scope = [&](const Synapse* synapse) {
+                return layer_id < 0 || synapse->get_postsynaptic_layer_id() == layer_id;
+            };
+
+            std::vector<std::size_t> offsets(neurons.size() + 1, 0);
+            for (auto& n: neurons) {
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    if (in_scope(axon_terminal.get())) {
+                        ++offsets[static_cast<std::size_t>(axon_terminal->get_postsynaptic_neuron_id()) + 1];
+                    }
+                }
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<Synapse*> incoming(offsets.back());
+            std::vector<std::size_t> cursor(offsets.begin(), offsets.end() - 1);
+            for (auto& n: neurons) {
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    if (in_scope(axon_terminal.get())) {
+                        incoming[cursor[static_cast<std::size_t>(axon_terminal->get_postsynaptic_neuron_id())]++] = axon_terminal.get();
+                    }
+                }
+            }
+
+            // the synapses to remove, sorted by address so both sides of each synapse can look them up
+            std::vector<Synapse*> removed;
+            for (std::size_t idx=0; idx<neurons.size(); ++idx) {
+                auto first = incoming.begin() + static_cast<std::ptrdiff_t>(offsets[idx]);
+                auto last = incoming.begin() + static_cast<std::ptrdiff_t>(offsets[idx+1]);
+                removed.insert(removed.end(), select(first, last), last);
+            }
+
+            if (removed.empty()) {
+                return 0;
+            }
+            std::sort(removed.begin(), removed.end());
+            auto is_removed = [&](const Synapse* synapse) {
+                return std::binary_search(removed.begin(), removed.end(), synapse);
+            };
+
+            for (auto& n: neurons) {
+                auto& dendritic_tree = n->get_dendritic_tree();
+                auto dendrites_end = std::remove_if(dendritic_tree.begin(), dendritic_tree.end(), is_removed);
+                if (dendrites_end != dendritic_tree.end()) {
+                    dendritic_tree.erase(dendrites_end, dendritic_tree.end());
+                    dendritic_tree.shrink_to_fit();
+                    n->synapses_pruned();
+                }
+
+                auto& axon_terminals = n->get_axon_terminals();
+                auto terminals_end = std::remove_if(axon_terminals.begin(), axon_terminals.end(), [&](const std::unique_ptr<Synapse>& synapse) {
+                    return is_removed(synapse.get());
+                });
+                if (terminals_end != axon_terminals.end()) {
+                    axon_terminals.erase(terminals_end, axon_terminals.end());
+                    axon_terminals.shrink_to_fit();
+                }
+            }
+            return removed.size();
+        }
+
+        // reverse Cuthill-McKee order of the undirected synaptic graph
+        std::vector<std::size_t> cuthill_mckee_rank() {
+            // building the adjacency lists in compressed form
+            std::vector<std::size_t> degree(neurons.size(), 0);
+            for (auto& n: neurons) {
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    ++degree[axon_terminal->get_presynaptic_neuron_id()];
+                    ++degree[axon_terminal->get_postsynaptic_neuron_id()];
+                }
+            }
+
+            std::vector<std::size_t> offsets(neurons.size()+1, 0);
+            for (std::size_t i=0; i<neurons.size(); ++i) {
+                offsets[i+1] = offsets[i] + degree[i];
+            }
+
+            std::vector<std::size_t> adjacency(offsets.back());
+            std::vector<std::size_t> fill(offsets.begin(), offsets.end()-1);
+            for (auto& n: neurons) {
+                for (auto& axon_terminal: n->get_axon_terminals()) {
+                    auto pre = static_cast<std::size_t>(axon_terminal->get_presynaptic_neuron_id());
+                    auto post = static_cast<std::size_t>(axon_terminal->get_postsynaptic_neuron_id());
+                    adjacency[fill[pre]++] = post;
+                    adjacency[fill[post]++] = pre;
+                }
+            }
+
+            auto by_degree = [&](std::size_t a, std::size_t b) {
+                return degree[a] < degree[b];
+            };
+
+            // breadth-first traversal starting from the lowest degree neuron of every connected component
+            std::vector<std::size_t> start_candidates(neurons.size());
+            std::iota(start_candidates.begin(), start_candidates.end(), 0);
+            std::stable_sort(start_candidates.begin(), start_candidates.end(), by_degree);
+
+            std::vector<bool> visited(neurons.size(), false);
+            std::vector<std::size_t> order;
+            order.reserve(neurons.size());
+            std::vector<std::size_t> neighbours;
+            for (auto start: start_candidates) {
+                if (visited[start]) {
+                    continue;
+                }
+
+                visited[start] = true;
+                order.emplace_back(start);
+                for (std::size_t head=order.size()-1; head<order.size(); ++head) {
+                    auto current = order[head];
+                    neighbours.clear();
+                    for (auto i=offsets[current]; i<offsets[current+1]; ++i) {
+                        if (!visited[adjacency[i]]) {
+                            visited[adjacency[i]] = true;
+                            neighbours.emplace_back(adjacency[i]);
+                        }
+                    }
+                    std::stable_sort(neighbours.begin(), neighbours.end(), by_degree);
+                    order.insert(order.end(), neighbours.begin(), neighbours.end());
+                }
+            }
+
+            std::vector<std::size_t> rank(neurons.size());
+            for (std::size_t i=0; i<order.size(); ++i) {
+                rank[order[i]] = order.size() - 1 - i;
+            }
+            return rank;
+        }
+
+        // tile-major order for neurons of 2D layers. neurons without a grid position keep their current order
+        std::vector<std::size_t> spatial_tiling_rank(int tile_size) {
+            std::vector<std::size_t> rank(neurons.size());
+            for (auto& l: layers) {
+                int tiles_per_row = (l.width + tile_size - 1) / tile_size;
+                for (auto idx: l.neurons) {
+                    auto [x, y] = neurons[idx]->get_xy_coordinates();
+                    if (l.width <= 0 || x < 0 || y < 0) {
+                        rank[idx] = idx;
+                    } else {
+                        auto tile = static_cast<std::size_t>((y / tile_size) * tiles_per_row + (x / tile_size));
+                        auto position_in_tile = static_cast<std::size_t>((y % tile_size) * tile_size + (x % tile_size));
+                        rank[idx] = tile * tile_size * tile_size + position_in_tile;
+                    }
+                }
+            }
+            return rank;
+        }
+
+        // gives every neuron the addons relevant to it, in the order of the addons: the ones without a mask go to every neuron unless they opted out with do_not_automatically_include, the others to the neurons of their mask. one pass over each mask, a bitmap skipping repeated entries
+        void bind_addons() {
+            std::vector<bool> bound(neurons.size(), false);
+            for (auto& addon: addons) {
+                auto& mask = addon->get_mask();
+                if (mask.empty()) {
+                    if (!addon->no_automatic_include()) {
+                        for (auto& n: neurons) {
+                            n->add_relevant_addon(addon.get());
+                        }
+                    }
+                    continue;
+                }
+
+                for (auto idx: mask) {
+                    if (idx < neurons.size() && !bound[idx]) {
+                        bound[idx] = true;
+                        neurons[idx]->add_relevant_addon(addon.get());
+                    }
+                }
+
+                for (auto idx: mask) {
+                    if (idx < neurons.size()) {
+                        bound[idx] = false;
+                    }
+                }
+            }
+        }
+
+        // events of one .es file selected for a presentation
+        struct es_presentation {
+            std::vector<es_event>                 events;
+            std::uint64_t                         last_t = 0; // timestamp of the last event read from the file, selected or not
+        };
+
+        // spikes of one .npy file, scaled and ready to be injected
+        struct npy_presentation {
+            std::vector<std::pair<int, double>>   spikes; // neuron and timestamp
+            double                                final_time = 0;
+        };
+
+        // decodes one .es file of a database. the events are read until t_max, and the ones outside the temporal and spatial crop or with the wrong polarity are dropped, as well as the gray level events of ATIS cameras. runs on the prefetching threads so it does not touch the network
+        static es_presentation load_es_file(const std::string& filename, uint64_t t_max, uint64_t t_min, int polarity, uint16_t x_max, uint16_t x_min, uint16_t y_max, uint16_t y_min) {
+            es_file file(filename);
+            if (file.get_header().event_stream_type != sepia::type::dvs && file.get_header().event_stream_type != sepia::type::atis) {
+                throw std::logic_error("unknown header type");
+            }
+
+            es_presentation presentation;
+            presentation.events = file.decode_events(t_max);
+            if (!presentation.events.empty()) {
+                presentation.last_t = presentation.events.back().t;
+            }
+
+            // filtering out gray level events, temporal crop and spatial crop and polarity selection. decode_events keeps the first event after t_max, which is dropped here
+            presentation.events.erase(std::remove_if(presentation.events.begin(), presentation.events.end(), [&](const es_event& event) {
+                return event.t > t_max || event.is_threshold_crossing || (polarity != 2 && event.polarity != polarity) || event.t < t_min || event.x < x_min || event.x > x_max || event.y < y_min || event.y > y_max;
+            }), presentation.events.end());
+            presentation.events.shrink_to_fit();
+            return presentation;
+        }
+
+        // loads one .npy file of a database formatted as [t, neuron_id]. runs on the prefetching threads so it does not touch the network
+        static npy_presentation load_npy_file(std::string filename, int scaling_factor) {
+            std::vector<int> size;
+            std::vector<double> data;
+            aoba::LoadArrayFromNumpy(filename, size, data);
+
+            if (size[0] != 2) {
+                throw std::logic_error(filename.append(" is formatted incorrectly. npy files only accept 1D data formatted as such: [t, neuron_id]. for 2D data, using the methods associated with the .es format is preferrable"));
+            }
+
+            npy_presentation presentation;
+            presentation.spikes.reserve(static_cast<std::size_t>(size[1]));
+            for (auto i=0; i<size[1]; ++i) {
+                presentation.spikes.emplace_back(static_cast<int>(data[i+size[1]]), data[i]*scaling_factor);
+                presentation.final_time = std::max(presentation.final_time, data[i]*scaling_factor);
+            }
+            return presentation;
+        }
+
+        // presents the events of one .es file through the input layer, until skip_presentation once set by a neuron. returns the timestamp of the last event presented
+        double present_es_events(const es_presentation& presentation, std::atomic_bool* running, bool classification, uint64_t t_max, uint16_t x_min, uint16_t y_min) {
+            double final_t = 0;
+            bool stopped = false;
+            for (auto& event: presentation.events) {
+                // stopping the event collection beyond a certain temporal threshold
+                if (event.t > skip_presentation || !running->load(std::memory_order_relaxed)) {
+                    stopped = true;
+                    break;
+                }
+
+                final_t = static_cast<double>(event.t);
+                es_run_helper(final_t, static_cast<int>(event.x), static_cast<int>(event.y), static_cast<int>(x_min), static_cast<int>(y_min), classification);
+            }
+
+            // the events dropped by load_es_file end the skip as well. timestamps only increase, so the last event read from the file tells whether one of them went past it
+            if (stopped || presentation.last_t > skip_presentation || presentation.last_t > t_max) {
+                skip_presentation = std::numeric_limits<double>::max();
+            }
+            return final_t;
+        }
+
+        // calls the neuron kernels through the virtual Neuron interface
+        struct virtual_dispatch {
+            Network* network;
+
+            void update(std::size_t idx, double timestamp, Synapse* s, float timestep, spike_type type) {
+                network->touch_neuron(idx);
+                network->neurons[idx]->update(timestamp, s, network, timestep, type);
+            }
+
+            void update_sync(std::size_t idx, double timestamp, Synapse* s, float timestep, spike_type type) {
+                network->touch_neuron(idx);
+                network->neurons[idx]->update_sync(timestamp, s, network, timestep, type);
+            }
+        };
+
+        // propagates one event from an .es file through the input layer
+        virtual void es_run_helper(double t, int x, int y, int x_min, int y_min, bool classification=false) {
+            virtual_dispatch dispatch{this};
+            es_run_loop(dispatch, t, x, y, x_min, y_min, classification);
+        }
+
+        // helper method that runs the network when event-mode is selected (timestep = 0)
+        virtual void async_run_helper(std::atomic_bool* running, bool classification=false, bool eof=false) {
+            virtual_dispatch dispatch{this};
+            async_run_loop(dispatch, running, classification, eof);
+        }
+
+        // helper function that runs the network when clock-mode is selected (timestep > 0)
+        virtual void sync_run_helper(std::atomic_bool* running, double runtime, float timestep, bool classification=false) {
+            virtual_dispatch dispatch{this};
+            sync_run_loop(dispatch, running, runtime, timestep, classification);
+        }
+
+        // synapse a spike is delivered through. spikes sent by a projection set the weight of their port first
+        static Synapse* route(const spike& s) {
+            if (s.source >= 0) {
+                s.propagation_synapse->route_from(s.source);
+            }
+            return s.propagation_synapse;
+        }
+
+        // event loops shared by Network and StaticNetwork. Dispatch decides how the neuron kernels are called
+        template <typename Dispatch>
+        void es_run_loop(Dispatch& dispatch, double t, int x, int y, int x_min, int y_min, bool classification) {
 
             // 1. find neuron corresponding to the event coordinates through 2D to 1D mapping
-            int idx = ((x - x_min) + layers[0].width * (y - y_min));
+            int idx = get_neuron_index((x - x_min) + layers[0].width * (y - y_min));
 
             // 2. make sure the neuron is actually from the input layer
             if (neurons.at(idx)->get_layer_id() != 0) {
@@ -2126,34 +4008,34 @@ namespace hummus {
             // if spike_queue and predicted_spikes are both empty: propagate the event through the correct input neuron
             if (spike_queue.empty() && predicted_spikes.empty()) {
                 spike s = neurons[idx]->receive_external_input(t, spike_type::initial, idx, -1, 1, 0);
-                neurons[idx]->update(t, s.propagation_synapse, this, 0, s.type);
+                dispatch.update(idx, t, s.propagation_synapse, 0, s.type);
             } else {
                 // propagate all spikes occuring before the event timestamp
                 while ((!spike_queue.empty() && spike_queue.top().timestamp < t) || (!predicted_spikes.empty() && predicted_spikes.front().timestamp < t)) {
                     if (!spike_queue.empty() && predicted_spikes.empty()) {
                         auto& s = spike_queue.top();
-                        neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                        dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
                         spike_queue.pop();
                     } else if (!predicted_spikes.empty() && spike_queue.empty()) {
                         auto& s = predicted_spikes.front();
-                        neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                        dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
                         predicted_spikes.pop_front();
                     } else if (!predicted_spikes.empty() && !spike_queue.empty()) {
                         if (spike_queue.top().timestamp < predicted_spikes.front().timestamp) {
                             auto& s = spike_queue.top();
-                            neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                            dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
                             spike_queue.pop();
                         } else if (predicted_spikes.front().timestamp < spike_queue.top().timestamp) {
                             auto& s = predicted_spikes.front();
-                            neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                            dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
                             predicted_spikes.pop_front();
                         } else {
                             auto& s = spike_queue.top();
-                            neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                            dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
                             spike_queue.pop();
 
                             auto& s2 = predicted_spikes.front();
-                            neurons[s2.propagation_synapse->get_postsynaptic_neuron_id()]->update(s2.timestamp, s2.propagation_synapse, this, 0, s2.type);
+                            dispatch.update(s2.propagation_synapse->get_postsynaptic_neuron_id(), s2.timestamp, route(s2), 0, s2.type);
                             predicted_spikes.pop_front();
                         }
                     }
@@ -2161,16 +4043,16 @@ namespace hummus {
 
                 // propagate the event through the correct input neuron
                 spike s = neurons[idx]->receive_external_input(t, spike_type::initial, idx, -1, 1, 0);
-                neurons[idx]->update(t, s.propagation_synapse, this, 0, s.type);
+                dispatch.update(idx, t, s.propagation_synapse, 0, s.type);
             }
 
             if (decision_making && classification && decision.timer > 0) {
                 choose_winner_online(t, 0);
             }
 
-            if (logistic_regression && decision.timer > 0 && layers[decision.layer_number].active) {
+            if (logistic_regression && decision.timer > 0 && is_layer_active(decision.layer_number)) {
                 if (t - decision_pre_ts >= decision.timer) {
-                    neurons[layers[decision.layer_number].neurons[0]]->update(t, nullptr, this, 0, spike_type::decision);
+                    dispatch.update(layers[decision.layer_number].neurons[0], t, nullptr, 0, spike_type::decision);
 
                     // saving previous timestamp
                     decision_pre_ts = t;
@@ -2178,8 +4060,8 @@ namespace hummus {
             }
         }
 
-        // helper method that runs the network when event-mode is selected (timestep = 0)
-        void async_run_helper(std::atomic_bool* running, bool classification=false, bool eof=false) {
+        template <typename Dispatch>
+        void async_run_loop(Dispatch& dispatch, std::atomic_bool* running, bool classification, bool eof) {
             // lambda function to update neuron status asynchronously
             auto requestUpdate = [&](spike s, bool classification) {
                 if (!eof && !classification) {
@@ -2211,16 +4093,16 @@ namespace hummus {
                         choose_winner_online(s.timestamp, 0);
                     }
                     
-                    if (logistic_regression && decision.timer > 0 && layers[decision.layer_number].active) {
+                    if (logistic_regression && decision.timer > 0 && is_layer_active(decision.layer_number)) {
                         if (s.timestamp - decision_pre_ts >= decision.timer) {
-                            neurons[layers[decision.layer_number].neurons[0]]->update(s.timestamp, nullptr, this, 0, spike_type::decision);
+                            dispatch.update(layers[decision.layer_number].neurons[0], s.timestamp, nullptr, 0, spike_type::decision);
                             
                             // saving previous timestamp
                             decision_pre_ts = s.timestamp;
                         }
                     }
                 }
-                neurons[s.propagation_synapse->get_postsynaptic_neuron_id()]->update(s.timestamp, s.propagation_synapse, this, 0, s.type);
+                dispatch.update(s.propagation_synapse->get_postsynaptic_neuron_id(), s.timestamp, route(s), 0, s.type);
             };
 
             if (!neurons.empty()) {
@@ -2257,8 +4139,8 @@ namespace hummus {
             }
         }
 
-        // helper function that runs the network when clock-mode is selected (timestep > 0)
-        void sync_run_helper(std::atomic_bool* running, double runtime, float timestep, bool classification=false) {
+        template <typename Dispatch>
+        void sync_run_loop(Dispatch& dispatch, std::atomic_bool* running, double runtime, float timestep, bool classification) {
             if (!neurons.empty()) {
 
                 // creating vector of the same size as neurons
@@ -2304,9 +4186,9 @@ namespace hummus {
                             choose_winner_online(i, timestep);
                         }
                         
-                        if (logistic_regression && decision.timer > 0 && layers[decision.layer_number].active) {
+                        if (logistic_regression && decision.timer > 0 && is_layer_active(decision.layer_number)) {
                             if (i - decision_pre_ts >= decision.timer) {
-                                neurons[layers[decision.layer_number].neurons[0]]->update(i, nullptr, this, timestep, spike_type::decision);
+                                dispatch.update(layers[decision.layer_number].neurons[0], i, nullptr, timestep, spike_type::decision);
                                 
                                 // saving previous timestamp
                                 decision_pre_ts = i;
@@ -2317,7 +4199,7 @@ namespace hummus {
                     while (!spike_queue.empty() && spike_queue.top().timestamp <= i) {
                         // access first element and update corresponding neuron
                         auto index = spike_queue.top().propagation_synapse->get_postsynaptic_neuron_id();
-                        neurons[index]->update_sync(i, spike_queue.top().propagation_synapse, this, timestep, spike_queue.top().type);
+                        dispatch.update_sync(index, i, route(spike_queue.top()), timestep, spike_queue.top().type);
                         neuronStatus[index] = true;
 
                         // remove first element
@@ -2331,10 +4213,10 @@ namespace hummus {
                         } else {
                             // only update neurons if the previous layer is propagating
                             if (neurons[idx]->get_layer_id() == 0) {
-                                neurons[idx]->update_sync(i, nullptr, this, timestep, spike_type::none);
+                                dispatch.update_sync(idx, i, nullptr, timestep, spike_type::none);
                             } else {
-                                if (layers[neurons[idx]->get_layer_id()].active) {
-                                    neurons[idx]->update_sync(i, nullptr, this, timestep, spike_type::none);
+                                if (is_layer_active(neurons[idx]->get_layer_id())) {
+                                    dispatch.update_sync(idx, i, nullptr, timestep, spike_type::none);
                                 }
                             }
                         }
@@ -2345,27 +4227,18 @@ namespace hummus {
             }
         }
 
-        std::vector<bool> find_successful_connections(int connection_ratio, int all_connections) {
-            if (connection_ratio < 100) {
-                std::vector<bool> connectivity_map(all_connections, false);
-                std::vector<int> indices(all_connections);
-                std::iota(indices.begin(), indices.end(), 0);
-
-                // calculate how many successful connections there should be according to the connection_ratio
-                int successful_connections = (connection_ratio * all_connections) / 100;
-
-                // Fisher–Yates shuffle to select successful probabilities without replacement
-                std::shuffle(indices.begin(), indices.end(), random_engine);
-
-                for (auto it = indices.begin(); it != std::next(indices.begin(), successful_connections); ++it) {
-                    connectivity_map[*it] = true;
-                }
-
-                return connectivity_map;
+        // picks connection_ratio % of all_connections without storing them. the layer connection methods ask for each connection in the order they enumerate them
+        connection_sampler find_successful_connections(int connection_ratio, std::size_t all_connections) {
+            if (connection_ratio >= 100) {
+                return connection_sampler(connection_sampling::bernoulli, 100, all_connections, philox_engine(0));
+            }
 
-            } else {
-                return std::vector<bool>(all_connections, true);
+            // seeded networks draw from their own stream, the others from the network random engine
+            if (seeded_construction) {
+                return connection_sampler(sampling, connection_ratio, all_connections, philox_engine(projection_key, std::numeric_limits<std::uint32_t>::max(), std::numeric_limits<std::uint32_t>::max(), selection_draws++));
             }
+            std::uint64_t key = (static_cast<std::uint64_t>(random_engine()) << 32) | random_engine();
+            return connection_sampler(sampling, connection_ratio, all_connections, philox_engine(key));
         }
         
         // ---- METHODS RELATED TO EVENT-BASED DECISION-MAKING CLASSIFIER ----
@@ -2387,15 +4260,16 @@ namespace hummus {
             // loop through last layer before DM
             for (auto& pre_decision_n: layers[decision.layer_number-1].neurons) {
                 auto& neuron_to_label = neurons[pre_decision_n];
-                if (!neuron_to_label->get_decision_queue().empty()) {
+                auto history = decision_labels.get_labels(pre_decision_n);
+                if (!history.empty()) {
 
                     // resetting the unordered map values to 0 for every neuron
                     for (auto& label: tmp_classes_map) {
                         label.second = 0;
                     }
 
-                    // loop through the decision_queue of a neuron and find the number of spikes per label
-                    for (auto label: neuron_to_label->get_decision_queue()) {
+                    // loop through the spike history of a neuron and find the number of spikes per label
+                    for (auto label: history) {
                         ++tmp_classes_map[label];
                     }
 
@@ -2406,7 +4280,7 @@ namespace hummus {
                                                                                 });
 
                     // assign label to neuron if element larger than the rejection threshold and does not hold less spikes than the spike_history_size
-                    float inv_queue_size = 100. / neuron_to_label->get_decision_queue().size();
+                    float inv_queue_size = 100. / history.size();
                     if (max_label.second * inv_queue_size >= decision.rejection_threshold && max_label.second >= decision.spike_history_size) {
                         neuron_to_label->set_class_label(max_label.first);
 
@@ -2445,6 +4319,7 @@ namespace hummus {
 
                 // update the best DecisionMaking neuron
                 if (winner_neuron != -1) {
+                    touch_neuron(static_cast<std::size_t>(winner_neuron));
                     neurons[winner_neuron]->update(t, nullptr, this, timestep, spike_type::decision);
                 } else {
                     if (verbose >= 1) {
@@ -2472,6 +4347,7 @@ namespace hummus {
 
             // update the best DecisionMaking neuron
             if (winner_neuron != -1) {
+                touch_neuron(static_cast<std::size_t>(winner_neuron));
                 neurons[winner_neuron]->update(t, nullptr, this, timestep, spike_type::decision);
             } else {
                 for (auto& addon: addons) {
@@ -2488,8 +4364,14 @@ namespace hummus {
         std::priority_queue<spike>              spike_queue;
         std::deque<spike>                       predicted_spikes;
         std::vector<layer>                      layers;
-		std::vector<std::unique_ptr<Neuron>>    neurons;
+        std::vector<bool>                       active_layers; // one bit per layer, mirrors layer::active
+        std::vector<std::unique_ptr<neuron_pool>> neuron_pools;
+        memory_policy                           neuron_memory_policy;
+		std::vector<neuron_handle>              neurons;
         std::vector<std::unique_ptr<Addon>>     addons;
+        std::vector<std::unique_ptr<Projection>> projections;
+        std::vector<std::vector<Projection*>>   outgoing_projections; // projections by presynaptic layer
+        std::vector<std::unique_ptr<LateralInhibition>> lateral_inhibitions;
         std::unique_ptr<MainAddon>              th_addon;
 		std::deque<label>                       training_labels;
         std::deque<label>                       test_labels;
@@ -2500,11 +4382,30 @@ namespace hummus {
         float                                   max_delay;
         bool                                    asynchronous;
         decision_heuristics                     decision;
+        decision_history                        decision_labels;
         double                                  decision_pre_ts;
         double                                  skip_presentation;
         bool                                    logistic_regression;
         int                                     presentation_counter; // for es_database method only
         std::mt19937                            random_engine;
         std::unordered_map<int, int>            classes_map;
+        std::vector<std::size_t>                user_ids; // id given at construction to each neuron. empty unless reorder_neurons was called
+        std::vector<std::size_t>                neuron_indices; // inverse of user_ids
+        bool                                    seeded_construction; // connections drawn from counter-based streams, see set_construction_seed
+        std::uint64_t                           construction_seed;
+        unsigned                                construction_threads;
+        std::uint64_t                           construction_calls; // number of layer connection methods called since set_construction_seed
+        std::uint64_t                           projection_key; // key of the streams of the current layer connection method
+        std::uint32_t                           selection_draws; // find_successful_connections calls in the current layer connection method
+        connection_sampling                     sampling;
+        std::string                             checkpoint_filename; // see set_training_checkpoints
+        int                                     checkpoint_interval;
+        std::size_t                             training_position; // training files already presented by the current database run
+        std::string                             next_training_file; // file the training resumes from, to check the database given after loading a checkpoint
+        std::uint32_t                           presentation_epoch; // incremented by every reset
+        std::vector<std::size_t>                touched_neurons; // neurons updated since the last reset
+        bool                                    full_reset_pending; // the next reset goes through every neuron, whose state may have been set outside the event loops
+        std::size_t                             prefetch_depth; // files loaded ahead by the database runs, see set_prefetching
+        std::size_t                             prefetch_threads;
     };
 }
@@ -21,6 +21,9 @@
 #include <random>
 #include <deque>
 #include <filesystem>
+#include <cstdint>
+
+#include "third_party/numpy.hpp"
 
 namespace hummus {
     
@@ -42,6 +45,70 @@ namespace hummus {
         std::deque<label>                    labels;
         std::unordered_map<std::string, int> class_map;
     };
+
+    // sparse connections between two layers in compressed sparse row (CSR) format: the connections of the i-th presynaptic neuron are the entries [row_offsets[i], row_offsets[i+1]) of columns, weights and delays. neurons are numbered by their position in their layer
+    struct sparse_connectivity {
+        std::size_t                          rows = 0; // presynaptic neurons
+        std::size_t                          columns = 0; // postsynaptic neurons
+        std::vector<std::size_t>             row_offsets = {0};
+        std::vector<std::uint32_t>           column_indices;
+        std::vector<float>                   weights;
+        std::vector<float>                   delays;
+
+        std::size_t size() const {
+            return column_indices.size();
+        }
+
+        // builds the CSR structure from coordinate (COO) triplets given in any order. rows and columns default to the largest indices found
+        static sparse_connectivity from_coo(const std::vector<std::uint32_t>& pre, const std::vector<std::uint32_t>& post, const std::vector<float>& weights, const std::vector<float>& delays, std::size_t rows=0, std::size_t columns=0) {
+            if (pre.size() != post.size() || pre.size() != weights.size() || (!delays.empty() && delays.size() != weights.size())) {
+                throw std::logic_error("the coordinate lists of the sparse connectivity do not have the same length");
+            }
+
+            sparse_connectivity matrix;
+            for (std::size_t i=0; i<pre.size(); ++i) {
+                rows = std::max(rows, static_cast<std::size_t>(pre[i]) + 1);
+                columns = std::max(columns, static_cast<std::size_t>(post[i]) + 1);
+            }
+            matrix.rows = rows;
+            matrix.columns = columns;
+
+            // two counting sorts, by postsynaptic then by presynaptic neuron, so the connections of a row are ordered by column whatever the order of the triplets
+            std::vector<std::size_t> column_offsets(columns + 1, 0);
+            for (auto column: post) {
+                ++column_offsets[column + 1];
+            }
+            for (std::size_t column=0; column<columns; ++column) {
+                column_offsets[column + 1] += column_offsets[column];
+            }
+            std::vector<std::size_t> by_column(post.size());
+            for (std::size_t i=0; i<post.size(); ++i) {
+                by_column[column_offsets[post[i]]++] = i;
+            }
+
+            matrix.row_offsets.assign(rows + 1, 0);
+            for (auto row: pre) {
+                ++matrix.row_offsets[row + 1];
+            }
+            for (std::size_t row=0; row<rows; ++row) {
+                matrix.row_offsets[row + 1] += matrix.row_offsets[row];
+            }
+
+            matrix.column_indices.resize(pre.size());
+            matrix.weights.resize(pre.size());
+            matrix.delays.resize(pre.size(), 0);
+            std::vector<std::size_t> cursors(matrix.row_offsets.begin(), matrix.row_offsets.end() - 1);
+            for (auto i: by_column) {
+                auto entry = cursors[pre[i]]++;
+                matrix.column_indices[entry] = post[i];
+                matrix.weights[entry] = weights[i];
+                if (!delays.empty()) {
+                    matrix.delays[entry] = delays[i];
+                }
+            }
+            return matrix;
+        }
+    };
 	
 	class DataParser {
         
@@ -284,6 +351,76 @@ namespace hummus {
             }
         }
 
+        // reads sparse connections from a .npy array of shape (connections, 3) or (connections, 4) holding presynaptic index, postsynaptic index, weight and optionally delay on each row (float64, like load_npy_data), or from a binary triplet file made of little-endian records (uint32 presynaptic index, uint32 postsynaptic index, float32 weight, float32 delay). the connections go straight into the CSR structure without a dense matrix
+        sparse_connectivity read_sparse_connectivity(const std::string& filename) {
+            std::vector<std::uint32_t> pre;
+            std::vector<std::uint32_t> post;
+            std::vector<float> weights;
+            std::vector<float> delays;
+
+            if (std::filesystem::path(filename).extension() == ".npy") {
+                std::vector<int> npy_shape;
+                std::vector<double> npy_data;
+                aoba::LoadArrayFromNumpy<double>(filename, npy_shape, npy_data);
+
+                if (npy_shape.size() != 2 || (npy_shape[1] != 3 && npy_shape[1] != 4)) {
+                    throw std::logic_error("npy file is not formatted correctly, the sparse connectivity needs (presynaptic index, postsynaptic index, weight[, delay]) rows");
+                }
+
+                auto connections = static_cast<std::size_t>(npy_shape[0]);
+                auto fields = static_cast<std::size_t>(npy_shape[1]);
+                pre.resize(connections);
+                post.resize(connections);
+                weights.resize(connections);
+                if (fields == 4) {
+                    delays.resize(connections);
+                }
+                for (std::size_t i=0; i<connections; ++i) {
+                    pre[i] = static_cast<std::uint32_t>(npy_data[i * fields]);
+                    post[i] = static_cast<std::uint32_t>(npy_data[i * fields + 1]);
+                    weights[i] = static_cast<float>(npy_data[i * fields + 2]);
+                    if (fields == 4) {
+                        delays[i] = static_cast<float>(npy_data[i * fields + 3]);
+                    }
+                }
+            } else {
+                std::ifstream triplet_file(filename, std::ios::binary | std::ios::ate);
+                if (!triplet_file.good()) {
+                    throw std::runtime_error(std::string(filename).append(" could not be opened. Please check that the path is set correctly"));
+                }
+
+                struct triplet {
+                    std::uint32_t pre;
+                    std::uint32_t post;
+                    float         weight;
+                    float         delay;
+                };
+                static_assert(sizeof(triplet) == 16, "the triplet records are 16 bytes long");
+
+                auto bytes = static_cast<std::size_t>(triplet_file.tellg());
+                if (bytes % sizeof(triplet) != 0) {
+                    throw std::logic_error(std::string(filename).append(" is not made of (uint32, uint32, float32, float32) records"));
+                }
+
+                std::vector<triplet> records(bytes / sizeof(triplet));
+                triplet_file.seekg(0);
+                triplet_file.read(reinterpret_cast<char*>(records.data()), static_cast<std::streamsize>(bytes));
+
+                pre.reserve(records.size());
+                post.reserve(records.size());
+                weights.reserve(records.size());
+                delays.reserve(records.size());
+                for (auto& r: records) {
+                    pre.emplace_back(r.pre);
+                    post.emplace_back(r.post);
+                    weights.emplace_back(r.weight);
+                    delays.emplace_back(r.delay);
+                }
+            }
+
+            return sparse_connectivity::from_coo(pre, post, weights, delays);
+        }
+
 		template <typename Container>
 		static Container& split(Container& result, const typename Container::value_type& s, const typename Container::value_type& delimiters) {
 			result.clear();
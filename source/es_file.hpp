@@ -0,0 +1,186 @@
+/*
+ * es_file.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Reader for the .es files of a database. The file is opened once and memory-mapped for sequential access, the header and the events are parsed straight from the mapping instead of going through two istreams and a reading thread. decode_events turns the DVS and ATIS streams into a plain array of events in one pass.
+ *
+ * Usage: auto events = hummus::es_file("pattern.es").decode_events();
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "third_party/sepia.hpp"
+#include "mapped_file.hpp"
+
+namespace hummus {
+
+    // event decoded by es_file::decode_events. polarity is 1 when the light increases. the gray level events of ATIS cameras are threshold crossings
+    struct es_event {
+        std::uint64_t                             t;
+        std::uint16_t                             x;
+        std::uint16_t                             y;
+        std::uint8_t                              polarity;
+        bool                                      is_threshold_crossing;
+    };
+
+    class es_file {
+
+    public:
+
+        // ----- CONSTRUCTOR -----
+        explicit es_file(const std::string& filename) :
+                file(filename, file_access::sequential),
+                header{},
+                first_event(nullptr),
+                last_event(nullptr) {
+
+            auto position = reinterpret_cast<const std::uint8_t*>(file.data());
+            auto end = position + file.size();
+
+            // same checks as sepia::read_header
+            auto signature = sepia::event_stream_signature();
+            if (file.size() < signature.size() || std::memcmp(position, signature.data(), signature.size()) != 0) {
+                throw sepia::wrong_signature();
+            }
+            position += signature.size();
+
+            if (end - position < static_cast<std::ptrdiff_t>(header.version.size() + 1)) {
+                throw sepia::incomplete_header();
+            }
+            std::memcpy(header.version.data(), position, header.version.size());
+            position += header.version.size();
+            if (std::get<0>(header.version) != std::get<0>(sepia::event_stream_version()) || std::get<1>(header.version) < std::get<1>(sepia::event_stream_version())) {
+                throw sepia::unsupported_version();
+            }
+
+            auto type_byte = *position++;
+            if (type_byte == static_cast<std::uint8_t>(sepia::type::generic)) {
+                header.event_stream_type = sepia::type::generic;
+            } else if (type_byte == static_cast<std::uint8_t>(sepia::type::dvs)) {
+                header.event_stream_type = sepia::type::dvs;
+            } else if (type_byte == static_cast<std::uint8_t>(sepia::type::atis)) {
+                header.event_stream_type = sepia::type::atis;
+            } else if (type_byte == static_cast<std::uint8_t>(sepia::type::color)) {
+                header.event_stream_type = sepia::type::color;
+            } else {
+                throw sepia::unsupported_event_type();
+            }
+
+            if (header.event_stream_type != sepia::type::generic) {
+                if (end - position < 4) {
+                    throw sepia::incomplete_header();
+                }
+                header.width = static_cast<std::uint16_t>(position[0] | (position[1] << 8));
+                header.height = static_cast<std::uint16_t>(position[2] | (position[3] << 8));
+                position += 4;
+            }
+
+            first_event = position;
+            last_event = end;
+        }
+
+        // ----- PUBLIC METHODS -----
+        // decodes a DVS or ATIS stream in one pass. each iteration reads a whole event, so there is no per-byte state machine or callback. decoding stops after the first event later than t_max, which is kept so the reader knows the stream went beyond it
+        std::vector<es_event> decode_events(std::uint64_t t_max=std::numeric_limits<std::uint64_t>::max()) const {
+            std::vector<es_event> events;
+            if (header.event_stream_type == sepia::type::dvs) {
+                decode<dvs_encoding>(events, t_max);
+            } else if (header.event_stream_type == sepia::type::atis) {
+                decode<atis_encoding>(events, t_max);
+            } else {
+                throw sepia::unsupported_event_type();
+            }
+            return events;
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        const sepia::header& get_header() const {
+            return header;
+        }
+
+    protected:
+
+        // an event starts with one byte carrying the time since the previous event and the polarity, followed by x and y on two little-endian bytes each. overflow bytes in between only move the time forward
+        struct dvs_encoding {
+            // returns true if the byte starts an event, otherwise adds the overflow to t
+            static bool starts_event(std::uint8_t byte, std::uint64_t& t) {
+                if (byte == 0b11111111) {
+                    t += 0b1111111;
+                    return false;
+                }
+                return byte != 0b11111110; // reset byte
+            }
+
+            static void read_first_byte(std::uint8_t byte, es_event& event) {
+                event.t += byte >> 1;
+                event.polarity = byte & 1;
+                event.is_threshold_crossing = false;
+            }
+        };
+
+        struct atis_encoding {
+            static bool starts_event(std::uint8_t byte, std::uint64_t& t) {
+                if ((byte & 0b11111100) == 0b11111100) {
+                    t += static_cast<std::uint64_t>(0b111111) * (byte & 0b11);
+                    return false;
+                }
+                return true;
+            }
+
+            static void read_first_byte(std::uint8_t byte, es_event& event) {
+                event.t += byte >> 2;
+                event.polarity = (byte >> 1) & 1;
+                event.is_threshold_crossing = (byte & 1) == 1;
+            }
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        // an event cut by the end of the file is dropped, as sepia does
+        template <typename Encoding>
+        void decode(std::vector<es_event>& events, std::uint64_t t_max) const {
+            events.reserve(static_cast<std::size_t>(last_event - first_event) / 5);
+
+            es_event event{};
+            auto byte = first_event;
+            while (byte != last_event) {
+                if (!Encoding::starts_event(*byte, event.t)) {
+                    ++byte;
+                    continue;
+                }
+                if (last_event - byte < 5) {
+                    break;
+                }
+
+                Encoding::read_first_byte(byte[0], event);
+                event.x = static_cast<std::uint16_t>(byte[1] | (byte[2] << 8));
+                event.y = static_cast<std::uint16_t>(byte[3] | (byte[4] << 8));
+                if (event.x >= header.width || event.y >= header.height) {
+                    throw sepia::coordinates_overflow();
+                }
+                byte += 5;
+
+                events.emplace_back(event);
+                if (event.t > t_max) {
+                    break;
+                }
+            }
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        mapped_file                               file;
+        sepia::header                             header;
+        const std::uint8_t*                       first_event;
+        const std::uint8_t*                       last_event;
+    };
+}
@@ -0,0 +1,201 @@
+/*
+ * inhibition.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Implicit lateral inhibition. Instead of one inhibitory synapse between every pair of neurons of a layer, the neurons are grouped into cells (same receptive field, or same position when a radius is given) and each cell keeps the decaying number of spikes it emitted. A spike costs a single entry in a queue of pending inhibitions, and the neurons read the cells around them when they are next updated. The inhibitory current follows the one of Exponential synapses with a uniform weight and delay, so the neurons behave as with Network::lateral_inhibition<hummus::Exponential> in the clock mode, except that the inhibitions reaching a neuron are integrated at the start of the timestep instead of in the order of the spike queue.
+ *
+ * Usage: network.implicit_lateral_inhibition(output, 1, 0.5);
+ */
+
+#pragma once
+
+#include <cmath>
+#include <deque>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+namespace hummus {
+
+    // whether the neurons of a layer inhibit every other sublayer or only their own
+    enum class inhibition_scope {
+        layer,
+        sublayer
+    };
+
+    class LateralInhibition {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        // home_cells: cell of every neuron of the layer, in the order of the layer. neighbourhoods: cells read by the neurons of each cell, stored one after the other and delimited by neighbourhood_offsets
+        LateralInhibition(int _layer_id, std::size_t _first_neuron, std::vector<std::size_t> _home_cells, std::vector<std::size_t> _neighbourhood_offsets, std::vector<std::size_t> _neighbourhoods, float _weight, float _delay, float _synapse_time_constant, float _external_current) :
+                layer_id(_layer_id),
+                first_neuron(_first_neuron),
+                home_cells(std::move(_home_cells)),
+                neighbourhood_offsets(std::move(_neighbourhood_offsets)),
+                neighbourhoods(std::move(_neighbourhoods)),
+                weight(-1 * std::abs(_weight)),
+                delay(_delay),
+                external_current(_external_current),
+                inv_s_tau(1.f / _synapse_time_constant),
+                cells(neighbourhood_offsets.size() - 1),
+                emitted(home_cells.size()),
+                received(home_cells.size()) {
+
+            // error handling
+            if (_synapse_time_constant <= 0) {
+                throw std::logic_error("The current decay value cannot be less than or equal to 0");
+            }
+
+            if (_delay < 0) {
+                throw std::logic_error("the inhibition delay cannot be negative");
+            }
+        }
+
+        // ----- PUBLIC METHODS -----
+        // a neuron of the layer fired. its peers are inhibited once the delay has elapsed
+        void neuron_fired(int neuron, double timestamp) {
+            pending.emplace_back(pending_inhibition{timestamp + delay, static_cast<std::size_t>(neuron) - first_neuron});
+        }
+
+        // inhibitory current of a neuron. like the spikes of an inhibitory synapse, the inhibitions reaching a neuron during its refractory period are lost
+        float current(int neuron, double timestamp, bool active) {
+            deliver(timestamp);
+
+            auto local = static_cast<std::size_t>(neuron) - first_neuron;
+            float inhibitions;
+            if (active) {
+                inhibitions = neighbourhood_count(local, timestamp) - decay(emitted[local], timestamp);
+            } else {
+                inhibitions = decay(received[local], timestamp);
+                emitted[local] = decaying_count{neighbourhood_count(local, timestamp) - inhibitions, timestamp};
+            }
+
+            received[local] = decaying_count{inhibitions, timestamp};
+            return weight * external_current * inhibitions;
+        }
+
+        // a neuron fired without bursting activity: its inhibitory current goes back to 0 like the currents of its synapses
+        void reset_neuron(int neuron, double timestamp) {
+            deliver(timestamp);
+
+            auto local = static_cast<std::size_t>(neuron) - first_neuron;
+            emitted[local] = decaying_count{neighbourhood_count(local, timestamp), timestamp};
+            received[local] = decaying_count{0, timestamp};
+        }
+
+        // back to the initial conditions, used by Network::reset_network
+        void reset() {
+            pending.clear();
+            std::fill(cells.begin(), cells.end(), decaying_count{});
+            std::fill(emitted.begin(), emitted.end(), decaying_count{});
+            std::fill(received.begin(), received.end(), decaying_count{});
+        }
+
+        // updates the per-neuron tables after Network::reorder_neurons, which only moves neurons within their sublayer
+        void relabel_neurons(const std::vector<std::size_t>& new_indices) {
+            std::vector<std::size_t> relabelled_cells(home_cells.size());
+            std::vector<decaying_count> relabelled_emitted(emitted.size());
+            std::vector<decaying_count> relabelled_received(received.size());
+            for (std::size_t local=0; local<home_cells.size(); ++local) {
+                auto new_local = new_indices[first_neuron + local] - first_neuron;
+                relabelled_cells[new_local] = home_cells[local];
+                relabelled_emitted[new_local] = emitted[local];
+                relabelled_received[new_local] = received[local];
+            }
+            home_cells = std::move(relabelled_cells);
+            emitted = std::move(relabelled_emitted);
+            received = std::move(relabelled_received);
+
+            for (auto& p: pending) {
+                p.neuron = new_indices[first_neuron + p.neuron] - first_neuron;
+            }
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        int get_layer_id() const {
+            return layer_id;
+        }
+
+        float get_weight() const {
+            return weight;
+        }
+
+        float get_delay() const {
+            return delay;
+        }
+
+        std::size_t get_memory_footprint() const {
+            return sizeof(LateralInhibition)
+                   + (home_cells.capacity() + neighbourhood_offsets.capacity() + neighbourhoods.capacity()) * sizeof(std::size_t)
+                   + (cells.capacity() + emitted.capacity() + received.capacity()) * sizeof(decaying_count)
+                   + pending.size() * sizeof(pending_inhibition);
+        }
+
+        // separate heap allocations: the object itself, every vector with storage, and the map and blocks of the pending deque (blocks of 512 bytes in libstdc++)
+        std::size_t get_heap_blocks() const {
+            std::size_t vectors = (home_cells.capacity() > 0) + (neighbourhood_offsets.capacity() > 0) + (neighbourhoods.capacity() > 0) + (cells.capacity() > 0) + (emitted.capacity() > 0) + (received.capacity() > 0);
+            constexpr std::size_t deque_block_size = std::max<std::size_t>(512 / sizeof(pending_inhibition), 1);
+            return 1 + vectors + 1 + pending.size() / deque_block_size + 1;
+        }
+
+    protected:
+
+        // number of spikes decaying with the synaptic time constant
+        struct decaying_count {
+            float  value = 0;
+            double time = 0;
+        };
+
+        struct pending_inhibition {
+            double      arrival;
+            std::size_t neuron;
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        float decay(const decaying_count& count, double timestamp) const {
+            return count.value * std::exp(- static_cast<float>(timestamp - count.time) * inv_s_tau);
+        }
+
+        // the inhibitions that arrived are counted at the update that reads them, which is when the spike of an inhibitory synapse would have been integrated
+        void deliver(double timestamp) {
+            while (!pending.empty() && pending.front().arrival <= timestamp) {
+                auto neuron = pending.front().neuron;
+                auto& cell = cells[home_cells[neuron]];
+                cell = decaying_count{decay(cell, timestamp) + 1, timestamp};
+                emitted[neuron] = decaying_count{decay(emitted[neuron], timestamp) + 1, timestamp};
+                pending.pop_front();
+            }
+        }
+
+        float neighbourhood_count(std::size_t local, double timestamp) const {
+            auto cell = home_cells[local];
+            float count = 0;
+            for (auto i=neighbourhood_offsets[cell]; i<neighbourhood_offsets[cell+1]; ++i) {
+                count += decay(cells[neighbourhoods[i]], timestamp);
+            }
+            return count;
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        int                                       layer_id;
+        std::size_t                               first_neuron;
+        std::vector<std::size_t>                  home_cells;
+        std::vector<std::size_t>                  neighbourhood_offsets;
+        std::vector<std::size_t>                  neighbourhoods;
+        float                                     weight;
+        float                                     delay;
+        float                                     external_current;
+        float                                     inv_s_tau;
+        std::vector<decaying_count>               cells;
+        std::vector<decaying_count>               emitted; // spikes of each neuron that reached its own neighbourhood, plus what it must not see after a reset or a refractory period
+        std::vector<decaying_count>               received; // inhibition read by each neuron at its last update
+        std::deque<pending_inhibition>            pending; // spikes in order of arrival, the delay being the same for every neuron
+    };
+}
@@ -0,0 +1,98 @@
+/*
+ * kernel_stdp.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: STDP on the shared kernels of a KernelProjection. The weight changes are the ones of the STDP learning rule, but every connection using a kernel entry contributes to that single entry.
+ *
+ * Usage: network.make_addon<hummus::KernelSTDP>(conv_projection);
+ */
+
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include "../addon.hpp"
+#include "../projections/convolution.hpp"
+
+namespace hummus {
+	class Neuron;
+
+	class KernelSTDP : public Addon {
+
+	public:
+		// ----- CONSTRUCTOR -----
+		KernelSTDP(KernelProjection& _projection, float _A_plus=1, float _A_minus=0.4, float _tau_plus=20, float _tau_minus=40) :
+                projection(_projection),
+                A_plus(_A_plus),
+                A_minus(_A_minus),
+                tau_plus(_tau_plus),
+                tau_minus(_tau_minus) {
+            subscribe_to({addon_hook::learn});
+            do_not_automatically_include = true;
+        }
+
+		// ----- PUBLIC METHODS -----
+        // the rule learns from the neurons on both sides of the projection
+		virtual void on_start(Network* network) override {
+            for (auto layer_id: {projection.get_presynaptic_layer_id(), projection.get_postsynaptic_layer_id()}) {
+                for (auto& n: network->get_layers()[layer_id].neurons) {
+                    auto& neuron = network->get_neurons()[n];
+                    auto& relevant_addons = neuron->get_relevant_addons();
+                    if (std::find(relevant_addons.begin(), relevant_addons.end(), this) == relevant_addons.end()) {
+                        neuron->add_relevant_addon(this);
+                    }
+                }
+            }
+		}
+
+		virtual void learn(double timestamp, Synapse* s, Neuron* postsynapticNeuron, Network* network) override {
+            auto& weights = projection.get_weights();
+
+            // LTD whenever a neuron from the presynaptic layer spikes
+            if (postsynapticNeuron->get_layer_id() == projection.get_presynaptic_layer_id()) {
+                projection.for_each_target(postsynapticNeuron->get_neuron_id(), [&](std::size_t port, std::size_t kernel_idx) {
+                    auto& at_postsynapticNeuron = network->get_neurons()[projection.get_port(port)->get_postsynaptic_neuron_id()];
+                    float dt = static_cast<float>(timestamp - at_postsynapticNeuron->get_previous_spike_time());
+                    if (at_postsynapticNeuron->get_trace() > 0.1) {
+                        update_weight(weights[kernel_idx], - A_minus * std::exp(-dt/tau_minus), network);
+                    }
+                });
+            }
+
+            // LTP whenever a neuron from the postsynaptic layer spikes
+            else if (postsynapticNeuron->get_layer_id() == projection.get_postsynaptic_layer_id()) {
+                auto port = static_cast<std::size_t>(network->get_user_id(postsynapticNeuron->get_neuron_id())) - network->get_layers()[projection.get_postsynaptic_layer_id()].neurons.first;
+                projection.for_each_source(port, [&](int presynaptic_neuron, std::size_t kernel_idx) {
+                    auto& d_presynapticNeuron = network->get_neurons()[presynaptic_neuron];
+                    float dt = static_cast<float>(d_presynapticNeuron->get_previous_spike_time() - timestamp);
+                    if (d_presynapticNeuron->get_trace() > 0.1) {
+                        update_weight(weights[kernel_idx], A_plus * std::exp(dt/tau_plus), network);
+                    }
+                });
+            }
+		}
+
+	protected:
+
+        // soft-bounded update of a kernel entry. like STDP, only excitatory weights within [0,1] learn
+        void update_weight(float& weight, float amplitude, Network* network) {
+            if (weight > 0 && weight <= 1) {
+                weight = std::max(weight + amplitude * weight * (1 - weight), 0.f);
+            } else if (weight > 1 && network->get_verbose() == 2) {
+                std::cout << "a kernel weight is higher than 1, this particular learning rule requires weights to fall within the [0,1] range. The weight was ignored and will not learn" << std::endl;
+            }
+        }
+
+		// ----- LEARNING RULE PARAMETERS -----
+        KernelProjection&    projection;
+		float                A_plus;
+		float                A_minus;
+		float                tau_plus;
+		float                tau_minus;
+	};
+}
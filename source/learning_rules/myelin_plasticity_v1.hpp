@@ -30,6 +30,7 @@ namespace hummus {
                 learning_rate(_learning_rate),
                 learning_window(_learning_window),
                 iterations(0) {
+            subscribe_to({addon_hook::learn});
             do_not_automatically_include = true;
         }
 		
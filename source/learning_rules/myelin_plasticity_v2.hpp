@@ -33,6 +33,7 @@ namespace hummus {
                 alpha_minus(_alpha_minus),
                 beta_plus(_beta_plus),
                 beta_minus(_beta_minus) {
+            subscribe_to({addon_hook::learn});
             do_not_automatically_include = true;
         }
 		
@@ -23,10 +23,12 @@ namespace hummus {
 		// ----- CONSTRUCTOR -----
 		STDP(float _A_plus=1, float _A_minus=0.4, float _tau_plus=20, float _tau_minus=40) :
                 pre_layer(-1),
+                post_layer(-1),
                 A_plus(_A_plus),
                 A_minus(_A_minus),
                 tau_plus(_tau_plus),
                 tau_minus(_tau_minus) {
+            subscribe_to({addon_hook::learn});
             do_not_automatically_include = true;
         }
 		
@@ -43,20 +45,18 @@ namespace hummus {
         
 		virtual void on_start(Network* network) override {
             if (!neuron_mask.empty()) {
-                for (auto& n: network->get_neurons()) {
-                    for (auto& addon: n->get_relevant_addons()) {
-                        if (addon == this) {
-                            if (n->get_layer_id() > 0) {
-                                post_layer = n->get_layer_id();
-                                // making sure we don't add learning on a parallel layer
-                                for (auto& dendrite: n->get_dendritic_tree()) {
-                                    auto& d_presynapticNeuron = network->get_neurons()[dendrite->get_presynaptic_neuron_id()];
-                                    auto& d_postsynapticNeuron = network->get_neurons()[dendrite->get_postsynaptic_neuron_id()];
-                                    if (d_presynapticNeuron->get_layer_id() < d_postsynapticNeuron->get_layer_id()) {
-                                        // finding the closest presynaptic layer without overly relying on layerIDs
-                                        pre_layer = std::max(d_presynapticNeuron->get_layer_id(), pre_layer);
-                                    }
-                                }
+                // the neurons of the mask are the ones the network bound the rule to. the postsynaptic layer is the deepest of their layers
+                for (auto& idx: neuron_mask) {
+                    auto& n = network->get_neurons()[idx];
+                    if (n->get_layer_id() > 0) {
+                        post_layer = std::max(n->get_layer_id(), post_layer);
+                        // making sure we don't add learning on a parallel layer
+                        for (auto& dendrite: n->get_dendritic_tree()) {
+                            auto& d_presynapticNeuron = network->get_neurons()[dendrite->get_presynaptic_neuron_id()];
+                            auto& d_postsynapticNeuron = network->get_neurons()[dendrite->get_postsynaptic_neuron_id()];
+                            if (d_presynapticNeuron->get_layer_id() < d_postsynapticNeuron->get_layer_id()) {
+                                // finding the closest presynaptic layer without overly relying on layerIDs
+                                pre_layer = std::max(d_presynapticNeuron->get_layer_id(), pre_layer);
                             }
                         }
                     }
@@ -28,6 +28,7 @@ namespace hummus {
                 G_max(_G_max),
                 G_min(_G_min),
                 lambda(_lambda) {
+            subscribe_to({addon_hook::learn});
             do_not_automatically_include = true;
         }
 		
@@ -0,0 +1,106 @@
+/*
+ * mapped_file.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Read-only view on the bytes of a file. The file is memory-mapped where available, so it is parsed straight from the page cache with a single open, otherwise it is read in one block. Used by the checkpoint and .es readers.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace hummus {
+
+    // how the file is going to be read, passed on to the kernel as a hint
+    enum class file_access {
+        random,
+        sequential
+    };
+
+    class mapped_file {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        explicit mapped_file(const std::string& filename, file_access access=file_access::random) :
+                bytes(nullptr),
+                length(0),
+                mapped(false) {
+
+            #if defined(__linux__) || defined(__APPLE__)
+            int descriptor = ::open(filename.c_str(), O_RDONLY);
+            if (descriptor >= 0) {
+                struct stat status;
+                if (::fstat(descriptor, &status) == 0 && status.st_size > 0) {
+                    void* mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+                    if (mapping != MAP_FAILED) {
+                        if (access == file_access::sequential) {
+                            ::madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_SEQUENTIAL);
+                        }
+                        ::madvise(mapping, static_cast<std::size_t>(status.st_size), MADV_WILLNEED);
+                        bytes = static_cast<const char*>(mapping);
+                        length = static_cast<std::size_t>(status.st_size);
+                        mapped = true;
+                    }
+                }
+                ::close(descriptor);
+            }
+            #endif
+
+            if (!mapped) {
+                std::ifstream file(filename, std::ios::binary | std::ios::ate);
+                if (!file.good()) {
+                    throw std::runtime_error(std::string(filename).append(" could not be opened. Please check that the path is set correctly"));
+                }
+                copy.resize(static_cast<std::size_t>(file.tellg()));
+                file.seekg(0);
+                file.read(copy.data(), static_cast<std::streamsize>(copy.size()));
+                bytes = copy.data();
+                length = copy.size();
+            }
+        }
+
+        mapped_file(const mapped_file&) = delete;
+        mapped_file& operator=(const mapped_file&) = delete;
+
+        ~mapped_file() {
+            #if defined(__linux__) || defined(__APPLE__)
+            if (mapped) {
+                ::munmap(const_cast<char*>(bytes), length);
+            }
+            #endif
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        const char* data() const {
+            return bytes;
+        }
+
+        std::size_t size() const {
+            return length;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        const char*                               bytes;
+        std::size_t                               length;
+        bool                                      mapped;
+        std::vector<char>                         copy; // file contents when it could not be mapped
+    };
+}
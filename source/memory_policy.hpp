@@ -0,0 +1,379 @@
+/*
+ * memory_policy.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: page size and NUMA placement options for the memory holding the neurons and synapses of large networks. The neurons of a pool are stored in one memory_block, and their synapses are carved from the chunks of a synapse_arena allocated with the same policy. Huge pages and NUMA placement are only available on linux, other platforms silently fall back to the standard allocator
+ */
+
+#pragma once
+
+#include <new>
+#include <mutex>
+#include <atomic>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <algorithm>
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace hummus {
+
+    enum class page_policy {
+        standard,               // regular allocator and 4 KB pages
+        transparent_huge_pages, // asks the kernel to back the memory with transparent huge pages
+        explicit_huge_pages     // uses the reserved hugetlbfs pages and falls back to transparent huge pages when none are left
+    };
+
+    enum class numa_policy {
+        first_touch, // pages are placed on the node of the thread that first writes to them
+        interleave   // pages are spread round-robin across every online node
+    };
+
+    struct memory_policy {
+        page_policy pages     = page_policy::standard;
+        numa_policy placement = numa_policy::first_touch;
+    };
+
+    // block of memory allocated according to a memory_policy
+    class memory_block {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        memory_block(std::size_t _bytes, std::size_t _alignment, memory_policy _policy) :
+                data(nullptr),
+                bytes(std::max<std::size_t>(_bytes, 1)),
+                alignment(_alignment),
+                mapped(false) {
+
+            #ifdef __linux__
+            if (_policy.pages != page_policy::standard || _policy.placement != numa_policy::first_touch) {
+                map(_policy);
+            }
+            #endif
+
+            if (!data) {
+                data = ::operator new(bytes, std::align_val_t(alignment));
+            }
+        }
+
+        memory_block(const memory_block&) = delete;
+        memory_block& operator=(const memory_block&) = delete;
+
+        memory_block(memory_block&& other) noexcept :
+                data(other.data),
+                bytes(other.bytes),
+                alignment(other.alignment),
+                mapped(other.mapped) {
+            other.data = nullptr;
+        }
+
+        memory_block& operator=(memory_block&& other) noexcept {
+            if (this != &other) {
+                release();
+                data = other.data;
+                bytes = other.bytes;
+                alignment = other.alignment;
+                mapped = other.mapped;
+                other.data = nullptr;
+            }
+            return *this;
+        }
+
+        ~memory_block() {
+            release();
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        void* get() const {
+            return data;
+        }
+
+        std::size_t size() const {
+            return bytes;
+        }
+
+        // true when the block was mapped directly from the kernel instead of the standard allocator
+        bool is_mapped() const {
+            return mapped;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        void release() {
+            if (!data) {
+                return;
+            }
+
+            #ifdef __linux__
+            if (mapped) {
+                munmap(data, bytes);
+                data = nullptr;
+                return;
+            }
+            #endif
+
+            ::operator delete(data, std::align_val_t(alignment));
+            data = nullptr;
+        }
+
+        #ifdef __linux__
+        void map(const memory_policy& policy) {
+            // huge pages are 2 MB on the platforms we run on. mmap returns page-aligned memory which covers the alignment of any neuron type
+            constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+            if (policy.pages != page_policy::standard) {
+                bytes = (bytes + huge_page_size - 1) / huge_page_size * huge_page_size;
+            }
+
+            void* address = MAP_FAILED;
+            if (policy.pages == page_policy::explicit_huge_pages) {
+                address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            }
+
+            if (address == MAP_FAILED) {
+                address = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+                if (address == MAP_FAILED) {
+                    return;
+                }
+
+                #ifdef MADV_HUGEPAGE
+                if (policy.pages != page_policy::standard) {
+                    madvise(address, bytes, MADV_HUGEPAGE);
+                }
+                #endif
+            }
+
+            // the memory policy has to be set before the pages are touched for the first time
+            if (policy.placement == numa_policy::interleave) {
+                interleave(address, bytes);
+            }
+
+            data = address;
+            mapped = true;
+        }
+
+        // calls mbind directly so we don't depend on libnuma. failures leave the default first-touch placement
+        static void interleave(void* address, std::size_t length) {
+            #ifdef SYS_mbind
+            constexpr int mpol_interleave = 3;
+            auto nodes = online_nodes();
+            if (nodes.size() < 2) {
+                return;
+            }
+
+            constexpr std::size_t bits_per_word = 8 * sizeof(unsigned long);
+            std::vector<unsigned long> node_mask(nodes.back() / bits_per_word + 1, 0);
+            for (auto n: nodes) {
+                node_mask[n / bits_per_word] |= 1UL << (n % bits_per_word);
+            }
+            syscall(SYS_mbind, address, length, mpol_interleave, node_mask.data(), node_mask.size() * bits_per_word + 1, 0);
+            #endif
+        }
+
+        // parses the node ranges listed in /sys/devices/system/node/online (e.g. "0-1,3")
+        static std::vector<std::size_t> online_nodes() {
+            std::vector<std::size_t> nodes;
+            std::ifstream online("/sys/devices/system/node/online");
+            std::string range;
+            while (std::getline(online, range, ',')) {
+                auto dash = range.find('-');
+                try {
+                    std::size_t first = std::stoul(range.substr(0, dash));
+                    std::size_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash+1));
+                    for (auto n=first; n<=last; ++n) {
+                        nodes.emplace_back(n);
+                    }
+                } catch (const std::exception&) {
+                    break;
+                }
+            }
+            return nodes;
+        }
+        #endif
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        void*                                     data;
+        std::size_t                               bytes;
+        std::size_t                               alignment;
+        bool                                      mapped;
+    };
+
+    // memory the synapses of a neuron pool are carved from, in chunks allocated with the memory_policy of the pool. each thread fills its own slab of a chunk, so the parallel construction does not contend on a lock and, with first-touch placement, the synapses end up on the node of the thread that created them. every synapse is preceded by the address of its arena (nullptr for the synapses allocated on the heap), which is how Synapse::operator delete finds where to return it
+    class synapse_arena {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        explicit synapse_arena(memory_policy _policy={}) :
+                policy(_policy),
+                id(++arena_count()),
+                next_chunk_bytes(first_chunk_bytes),
+                chunk_cursor(nullptr),
+                chunk_end(nullptr),
+                reserved(0),
+                free_count(0),
+                closing(false) {}
+
+        synapse_arena(const synapse_arena&) = delete;
+        synapse_arena& operator=(const synapse_arena&) = delete;
+
+        // ----- PUBLIC METHODS -----
+        // memory for an object of size bytes aligned on 16 bytes, taken from the arena or from the heap when there is none
+        static void* allocate(synapse_arena* arena, std::size_t size) {
+            char* object;
+            if (arena) {
+                object = arena->take(block_size(size)) + header_bytes;
+            } else {
+                object = static_cast<char*>(::operator new(size + 2 * header_bytes)) + 2 * header_bytes;
+            }
+            *owner_slot(object) = arena;
+            return object;
+        }
+
+        // returns the memory of a synapse of size bytes allocated with allocate
+        static void deallocate(void* object, std::size_t size) {
+            if (auto arena = owner(object)) {
+                arena->give_back(static_cast<char*>(object) - header_bytes, block_size(size));
+            } else {
+                ::operator delete(static_cast<char*>(object) - 2 * header_bytes);
+            }
+        }
+
+        // arena an object was allocated from, nullptr if it lives on the heap
+        static synapse_arena* owner(const void* object) {
+            return *owner_slot(const_cast<void*>(object));
+        }
+
+        // the synapses are about to be destroyed together with the arena, so their memory does not need to be recycled
+        void close() {
+            closing.store(true, std::memory_order_relaxed);
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        // bytes of the chunks, including the headers and the space not handed out yet
+        std::size_t get_memory_footprint() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return reserved;
+        }
+
+        // number of chunks taken from the standard allocator
+        std::size_t get_heap_blocks() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return static_cast<std::size_t>(std::count_if(chunks.begin(), chunks.end(), [](const memory_block& chunk) { return !chunk.is_mapped(); }));
+        }
+
+        // bytes an object of size bytes takes in an arena, header included
+        static std::size_t block_size(std::size_t size) {
+            return (size + header_bytes + 15) & ~static_cast<std::size_t>(15);
+        }
+
+    protected:
+
+        // slab of a chunk being filled by one thread
+        struct thread_slab {
+            std::uint64_t  arena = 0;
+            char*          cursor = nullptr;
+            char*          end = nullptr;
+        };
+
+        static constexpr std::size_t header_bytes = sizeof(void*);
+        static constexpr std::size_t slab_bytes = 16 * 1024;
+        static constexpr std::size_t first_chunk_bytes = 64 * 1024;
+        static constexpr std::size_t max_chunk_bytes = 2 * 1024 * 1024;
+
+        // ----- IMPLEMENTATION METHODS -----
+        static synapse_arena** owner_slot(void* object) {
+            return reinterpret_cast<synapse_arena**>(static_cast<char*>(object) - header_bytes);
+        }
+
+        // arenas are told apart by a number that is never reused, so a slab left over by a destroyed arena is not mistaken for one of a new arena at the same address
+        static std::atomic<std::uint64_t>& arena_count() {
+            static std::atomic<std::uint64_t> count(0);
+            return count;
+        }
+
+        static thread_slab& current_slab() {
+            static thread_local thread_slab slab;
+            return slab;
+        }
+
+        // blocks start 8 bytes past a multiple of 16 so the objects after their header are aligned on 16 bytes
+        char* take(std::size_t bytes) {
+            if (free_count.load(std::memory_order_relaxed) > 0) {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto size_class = bytes / 16;
+                if (size_class < free_lists.size() && free_lists[size_class]) {
+                    char* block = free_lists[size_class];
+                    free_lists[size_class] = *reinterpret_cast<char**>(block + header_bytes);
+                    free_count.fetch_sub(1, std::memory_order_relaxed);
+                    return block;
+                }
+            }
+
+            auto& slab = current_slab();
+            if (slab.arena != id || static_cast<std::size_t>(slab.end - slab.cursor) < bytes) {
+                refill(slab, bytes);
+            }
+            char* block = slab.cursor;
+            slab.cursor += bytes;
+            return block;
+        }
+
+        void refill(thread_slab& slab, std::size_t bytes) {
+            std::lock_guard<std::mutex> lock(mutex);
+            // a whole number of blocks, so a slab filled with synapses of one model has no unused tail
+            auto wanted = std::max<std::size_t>(slab_bytes / bytes, 1) * bytes;
+            if (static_cast<std::size_t>(chunk_end - chunk_cursor) < wanted) {
+                chunks.emplace_back(std::max(next_chunk_bytes, wanted + 2 * header_bytes), 16, policy);
+                next_chunk_bytes = std::min(2 * next_chunk_bytes, max_chunk_bytes);
+                reserved += chunks.back().size();
+                chunk_cursor = static_cast<char*>(chunks.back().get()) + header_bytes;
+                chunk_end = static_cast<char*>(chunks.back().get()) + chunks.back().size() - header_bytes;
+            }
+            slab.arena = id;
+            slab.cursor = chunk_cursor;
+            slab.end = chunk_cursor + wanted;
+            chunk_cursor += wanted;
+        }
+
+        // freed blocks are chained through the memory of the destroyed synapse, one list per size
+        void give_back(char* block, std::size_t bytes) {
+            if (closing.load(std::memory_order_relaxed)) {
+                return;
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            auto size_class = bytes / 16;
+            if (size_class >= free_lists.size()) {
+                free_lists.resize(size_class + 1, nullptr);
+            }
+            *reinterpret_cast<char**>(block + header_bytes) = free_lists[size_class];
+            free_lists[size_class] = block;
+            free_count.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        memory_policy                             policy;
+        std::uint64_t                             id;
+        std::size_t                               next_chunk_bytes;
+        char*                                     chunk_cursor; // part of the last chunk not given to a slab yet
+        char*                                     chunk_end;
+        std::size_t                               reserved;
+        std::vector<memory_block>                 chunks;
+        std::vector<char*>                        free_lists;
+        std::atomic<std::size_t>                  free_count;
+        std::atomic<bool>                         closing;
+        mutable std::mutex                        mutex;
+    };
+}
@@ -4,54 +4,86 @@
  *
  * Created by Omar Oubari.
  * Email: omar.oubari@inserm.fr
- * Last Version: 21/01/2019
+ * Last Version: 18/10/2026
  *
- * Information: current-based leaky integrate and fire (LIF) neuron model
+ * Information: current-based leaky integrate and fire (LIF) neuron model. The optional behaviours (winner-takes-all, homeostasis, bursting, verbose print-outs, the GUI hooks and the decision-making spike history) come from a feature policy: CUBA_LIF reads them from the flags given to its constructor, while Static_CUBA_LIF fixes them at compile time with lif_features so the disabled ones cost nothing in the update loop.
+ *
+ * Usage: network.make_grid<hummus::CUBA_LIF>(input, 4, 3, 1, {}, 3, 200, 10, false, false, false); network.make_grid<hummus::Static_CUBA_LIF<hummus::lif_features<true>>>(input, 4, 3, 1, {}, 3, 200, 10);
  */
 
 #pragma once
 
+#include <type_traits>
+
 namespace hummus {
-    
+
     class Synapse;
     class Neuron;
     class Network;
-    
-	class CUBA_LIF : public Neuron {
-        
-	public:
-		// ----- CONSTRUCTOR AND DESTRUCTOR -----
-        CUBA_LIF(int _neuronID, int _layerID, int _sublayerID, int _rf_id,  std::pair<int, int> _xyCoordinates, int _refractoryPeriod=3, float _capacitance=200, float _leakageConductance=10, bool _wta=false, bool _homeostasis=false, bool _burstingActivity=false, float _traceTimeConstant=10, float _decayHomeostasis=20, float _homeostasisBeta=0.1, float _threshold=-50, float _restingPotential=-70, int _classLabel=01) :
-                Neuron(_neuronID, _layerID, _sublayerID, _rf_id, _xyCoordinates, _refractoryPeriod, _capacitance, _leakageConductance, _traceTimeConstant, _threshold, _restingPotential, _classLabel),
+
+    // features chosen at run time with the constructor flags and the setters of CUBA_LIF
+    struct runtime_features {
+        bool                         wta; // resets the potential of the whole layer when the neuron fires
+        bool                         homeostasis; // adaptive threshold (clock mode only)
+        bool                         bursting_activity; // keeps the synaptic currents after firing
+        static constexpr bool        verbose = true; // allows the verbose=2 print-outs
+        static constexpr bool        main_thread_addon = true; // forwards the events to the GUI
+        static constexpr bool        decision_history = true; // records spike labels when the next layer is the decision-making layer
+
+        runtime_features(bool _wta, bool _homeostasis, bool _burstingActivity) :
                 wta(_wta),
-                bursting_activity(_burstingActivity),
                 homeostasis(_homeostasis),
-                resting_threshold(_threshold),
-                decay_homeostasis(_decayHomeostasis),
-                homeostasis_beta(_homeostasisBeta),
-                active_synapse(nullptr),
-                refractory_counter(0) {
-                    
-            inv_trace_tau = 1. / _traceTimeConstant;
-            inv_membrane_tau = 1./ membrane_time_constant;
-            inv_homeostasis_tau = 1. / _decayHomeostasis;
-		}
-		
-		virtual ~CUBA_LIF(){}
-		
-		// ----- PUBLIC LIF METHODS -----        
+                bursting_activity(_burstingActivity) {}
+
+        void serialise(state_archive& archive) {
+            archive(wta, bursting_activity, homeostasis);
+        }
+
+        static std::string model_name() {
+            return "CUBA_LIF";
+        }
+    };
+
+    // features fixed at compile time, see runtime_features for their meaning
+    template <bool WTA=false, bool Homeostasis=false, bool BurstingActivity=false, bool Verbose=false, bool MainThreadAddon=false, bool DecisionHistory=false>
+    struct lif_features {
+        static constexpr bool        wta = WTA;
+        static constexpr bool        homeostasis = Homeostasis;
+        static constexpr bool        bursting_activity = BurstingActivity;
+        static constexpr bool        verbose = Verbose;
+        static constexpr bool        main_thread_addon = MainThreadAddon;
+        static constexpr bool        decision_history = DecisionHistory;
+
+        void serialise(state_archive&) {}
+
+        static std::string model_name() {
+            return std::string("Static_CUBA_LIF<") + (WTA ? "1" : "0") + (Homeostasis ? "1" : "0") + (BurstingActivity ? "1" : "0") + (Verbose ? "1" : "0") + (MainThreadAddon ? "1" : "0") + (DecisionHistory ? "1" : "0") + ">";
+        }
+    };
+
+    // every feature turned on: behaves like a CUBA_LIF configured with the same flags
+    using all_lif_features = lif_features<true, true, true, true, true, true>;
+
+    template <typename Features>
+	class basic_cuba_lif : public Neuron {
+
+	public:
+		// ----- CONSTRUCTOR AND DESTRUCTOR -----
+        // runtime features take their flags from the constructor, compile-time features from the type
+        template <typename F=Features, std::enable_if_t<std::is_constructible_v<F, bool, bool, bool>, int> = 0>
+        basic_cuba_lif(int _neuronID, int _layerID, int _sublayerID, int _rf_id,  std::pair<int, int> _xyCoordinates, int _refractoryPeriod=3, float _capacitance=200, float _leakageConductance=10, bool _wta=false, bool _homeostasis=false, bool _burstingActivity=false, float _traceTimeConstant=10, float _decayHomeostasis=20, float _homeostasisBeta=0.1, float _threshold=-50, float _restingPotential=-70, int _classLabel=01) :
+                basic_cuba_lif(Features(_wta, _homeostasis, _burstingActivity), _neuronID, _layerID, _sublayerID, _rf_id, _xyCoordinates, _refractoryPeriod, _capacitance, _leakageConductance, _traceTimeConstant, _decayHomeostasis, _homeostasisBeta, _threshold, _restingPotential, _classLabel) {}
+
+        template <typename F=Features, std::enable_if_t<!std::is_constructible_v<F, bool, bool, bool>, int> = 0>
+        basic_cuba_lif(int _neuronID, int _layerID, int _sublayerID, int _rf_id,  std::pair<int, int> _xyCoordinates, int _refractoryPeriod=3, float _capacitance=200, float _leakageConductance=10, float _traceTimeConstant=10, float _decayHomeostasis=20, float _homeostasisBeta=0.1, float _threshold=-50, float _restingPotential=-70, int _classLabel=0) :
+                basic_cuba_lif(Features(), _neuronID, _layerID, _sublayerID, _rf_id, _xyCoordinates, _refractoryPeriod, _capacitance, _leakageConductance, _traceTimeConstant, _decayHomeostasis, _homeostasisBeta, _threshold, _restingPotential, _classLabel) {}
+
+		basic_cuba_lif(basic_cuba_lif&&) = default;
+
+		virtual ~basic_cuba_lif(){}
+
+		// ----- PUBLIC LIF METHODS -----
 		virtual void initialisation(Network* network) override {
-            // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically not filtered out unless specified by the no_automatic_include() flag (tells the neuron not to automatically include the addon)
-            for (auto& addon: network->get_addons()) {
-                if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                    add_relevant_addon(addon.get());
-                } else {
-                    if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                        add_relevant_addon(addon.get());
-                    }
-                }
-            }
-            
             // asynchronous network cannot use exponential synapses
             if (network->is_asynchronous()) {
                 if (std::any_of(axon_terminals.begin(), axon_terminals.end(), [](std::unique_ptr<Synapse>& synapse) {
@@ -61,20 +93,18 @@ namespace hummus {
                 }
             }
 		}
-        
+
         // homeostasis does not work for the event-based neuron because it would complicate spike prediction
         virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
-            
-            if (network->get_main_thread_addon()) {
-                network->get_main_thread_addon()->status_update(timestamp, this, network);
-            }
-            
+
+            gui_status_update(timestamp, network);
+
             // checking whether a refractory period is over
             if (timestamp - previous_spike_time >= refractory_period) {
                 active = true;
             }
 
-            
+
             // updating current of synapses
             if (type == spike_type::initial) {
                 current = s->update(timestamp, timestep);
@@ -85,11 +115,11 @@ namespace hummus {
                 }
                 current = total_current;
             }
-            
+
             float input_td = static_cast<float>(timestamp - previous_input_time);
-            
+
             if (type == spike_type::initial || type == spike_type::generated) {
-                
+
                 float exp_input_mem_tau = std::exp(- input_td * inv_membrane_tau);
 
                 // trace decay
@@ -97,19 +127,19 @@ namespace hummus {
                 if (trace < 0) {
                     trace = 0;
                 }
-                
+
                 // potential decay
                 potential += (resting_potential - potential) * input_td * inv_membrane_tau;
-                
+
                 if (active) {
                     network->inject_spike(spike{timestamp + s->get_synapse_time_constant(), s, spike_type::end_of_integration});
-                    
+
 					// calculating the potential before any spike integration
                     potential = resting_potential + current * (1 - exp_input_mem_tau) + (potential - resting_potential) * exp_input_mem_tau;
-                    
+
                     // sending spike to relevant synapse
                     s->receive_spike();
-                    
+
                     if (type == spike_type::initial) {
                         current = s->get_synaptic_current();
                     } else {
@@ -120,24 +150,20 @@ namespace hummus {
                         }
                         current = total_current;
                     }
-                    
+
                     previous_input_time = timestamp;
                     s->set_previous_input_time(timestamp);
-                    
-                    if (network->get_verbose() == 2) {
-                        std::cout << "t=" << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " w=" << s->get_weight() << " d=" << s->get_delay() <<" V=" << potential << " Vth=" << threshold << " layer=" << layer_id << " --> EMITTED"  << std::endl;
-                    }
-                    
-                    for (auto& addon: relevant_addons) {
+
+                    print_event(timestamp, s, network, "EMITTED");
+
+                    for (auto& addon: get_addons_for(addon_hook::incoming_spike)) {
                         if (potential < threshold) {
                             addon->incoming_spike(timestamp, s, this, network);
                         }
                     }
 
-                    if (network->get_main_thread_addon()) {
-                        network->get_main_thread_addon()->incoming_spike(timestamp, s, this, network);
-                    }
-                    
+                    gui_incoming_spike(timestamp, s, network);
+
                     if (current > 0) {
                         // calculating time at which potential = threshold
                         double predictedTimestamp = membrane_time_constant * (- std::log( - threshold + resting_potential + current) + std::log( current - potential + resting_potential)) + timestamp;
@@ -157,81 +183,36 @@ namespace hummus {
                     potential = resting_potential + current * (1 - exp_s_tau_mem_tau) + (potential - resting_potential) * exp_s_tau_mem_tau;
                 }
             }
-                
-            if (network->get_main_thread_addon()) {
-                network->get_main_thread_addon()->status_update(timestamp, this, network);
-            }
-            
+
+            gui_status_update(timestamp, network);
+
             if (type != spike_type::end_of_integration && potential >= threshold) {
-                // save spikes on final LIF layer before the Decision Layer for classification purposes if there's a decision-making layer
-                if (network->get_learning_status() && network->get_decision_making() && network->get_decision_parameters().layer_number == layer_id+1) {
-                    if (static_cast<int>(decision_queue.size()) < network->get_decision_parameters().spike_history_size) {
-                        decision_queue.emplace_back(network->get_current_label());
-                    } else {
-                        decision_queue.pop_front();
-                        decision_queue.emplace_back(network->get_current_label());
-                    }
-                }
-                
-                trace = 1;
-                
-                if (network->get_verbose() == 2) {
-                    std::cout << "t=" << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " w=" << s->get_weight() << " d=" << s->get_delay() <<" V=" << potential << " Vth=" << threshold << " layer=" << layer_id << " --> SPIKED" << std::endl;
-                }
-                
-                for (auto& addon: relevant_addons) {
-                    addon->neuron_fired(timestamp, s, this, network);
-                }
-                
-                if (network->get_main_thread_addon()) {
-                    network->get_main_thread_addon()->neuron_fired(timestamp, s, this, network);
-                }
-                
-                for (auto& axonTerminal : axon_terminals) {
-                    auto& post_synaptic_layer = network->get_layers()[network->get_neurons()[axonTerminal->get_postsynaptic_neuron_id()]->get_layer_id()];
-                    if (post_synaptic_layer.active) {
-                        network->inject_spike(spike{timestamp + axonTerminal->get_delay(), axonTerminal.get(), spike_type::generated});
-                    }
-                }
-                
-                request_learning(timestamp, s, this, network);
-                
-                if (wta) {
-                    winner_takes_all(timestamp, network);
-                }
-                
-                if (network->get_main_thread_addon()) {
-                    network->get_main_thread_addon()->status_update(timestamp, this, network);
-                }
-                
+                fire(timestamp, s, network);
+
+                gui_status_update(timestamp, network);
+
                 // resetting the current after firing if we don't want the neuron to burst
-                if (!bursting_activity) {
-                    for (auto& synapse: dendritic_tree) {
-                        synapse->reset();
-                    }
-                }
-                
+                reset_currents(timestamp);
+
                 previous_spike_time = timestamp;
                 active = false;
                 current = 0;
-                
-                if (network->get_main_thread_addon()) {
-                    network->get_main_thread_addon()->status_update(timestamp, this, network);
-                }
+
+                gui_status_update(timestamp, network);
             }
 		}
-		
+
         virtual void update_sync(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
-            
+
             // handling multiple spikes at the same timestamp (to prevent excessive decay)
             if (timestamp != 0 && timestamp - previous_input_time == 0) {
                 timestep = 0;
             }
-            
+
             if (timestamp - previous_spike_time >= refractory_period) {
                 active = true;
             }
-            
+
             // updating current of synapses
             if (type == spike_type::initial) {
                 current = s->update(timestamp, timestep);
@@ -240,37 +221,37 @@ namespace hummus {
                 for (auto& synapse: dendritic_tree) {
                     total_current += synapse->update(timestamp, timestep);
                 }
-                current = total_current;
+                current = total_current + lateral_inhibition_current(timestamp);
             }
-            
+
             // trace decay
             trace -= timestep * inv_trace_tau;
             if (trace < 0) {
                 trace = 0;
             }
-                        
+
 			// potential decay
             potential = resting_potential + (potential - resting_potential) * std::exp( - timestep * inv_membrane_tau);
-            
+
 			// threshold decay
-			if (homeostasis) {
+			if (features.homeostasis) {
                 threshold = resting_threshold + (threshold - resting_threshold) * std::exp( - timestep * inv_homeostasis_tau);
 			}
-                
+
 			// neuron inactive during refractory period
 			if (active) {
 				if (s) {
-                    
+
                     active_synapse = s;
-                    
+
 					// updating the threshold
-					if (homeostasis) {
+					if (features.homeostasis) {
 						threshold += homeostasis_beta * inv_homeostasis_tau;
 					}
-                    
+
                     // sending spike to relevant synapse
                     s->receive_spike();
-                    
+
                     // integating synaptic currents
                     if (type == spike_type::initial) {
                         current = s->get_synaptic_current();
@@ -279,165 +260,214 @@ namespace hummus {
                         for (auto& synapse: dendritic_tree) {
                             total_current += synapse->get_synaptic_current();
                         }
-                        current = total_current;
+                        current = total_current + lateral_inhibition_current(timestamp);
                     }
-                    
+
                     // updating the timestamp when a synapse was propagating a spike
                     previous_input_time = timestamp;
                     s->set_previous_input_time(timestamp);
-                    
-                    if (network->get_verbose() == 2) {
-                        std::cout << "t=" << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " w=" << s->get_weight() << " d=" << s->get_delay() <<" V=" << potential << " Vth=" << threshold << " layer=" << layer_id << " --> EMITTED" << std::endl;
-                    }
-                    
-                    for (auto& addon: relevant_addons) {
+
+                    print_event(timestamp, s, network, "EMITTED");
+
+                    for (auto& addon: get_addons_for(addon_hook::incoming_spike)) {
                         addon->incoming_spike(timestamp, s, this, network);
                     }
-                    
-                    if (network->get_main_thread_addon()) {
-                        network->get_main_thread_addon()->incoming_spike(timestamp, s, this, network);
-                    }
+
+                    gui_incoming_spike(timestamp, s, network);
 				}
-				
+
                 potential += current * (1 - std::exp(-timestep * inv_membrane_tau));
             }
-            
-            for (auto& addon: relevant_addons) {
+
+            for (auto& addon: get_addons_for(addon_hook::status_update)) {
                 addon->status_update(timestamp, this, network);
             }
-            
-            if (network->get_main_thread_addon()) {
-                network->get_main_thread_addon()->status_update(timestamp, this, network);
-            }
-            
+
+            gui_status_update(timestamp, network);
+
 			if (potential >= threshold && active_synapse) {
-                
-                // save spikes on final LIF layer before the Decision Layer for classification purposes if there's a decision-making layer
-                if (network->get_learning_status() &&  network->get_decision_making() && network->get_decision_parameters().layer_number == layer_id+1) {
-                    if (static_cast<int>(decision_queue.size()) < network->get_decision_parameters().spike_history_size) {
-                        decision_queue.emplace_back(network->get_current_label());
-                    } else {
-                        decision_queue.pop_front();
-                        decision_queue.emplace_back(network->get_current_label());
-                    }
-                }
-                
-                trace = 1;
-                
-                if (network->get_verbose() == 2) {
-                    std::cout << "t=" << timestamp << " " << active_synapse->get_presynaptic_neuron_id() << "->" << neuron_id << " w=" << active_synapse->get_weight() << " d=" << active_synapse->get_delay() <<" V=" << potential << " Vth=" << threshold << " layer=" << layer_id << " --> SPIKED" << std::endl;
-                }
-                
-                for (auto& addon: relevant_addons) {
-                    addon->neuron_fired(timestamp, active_synapse, this, network);
-				}
-                
-                if (network->get_main_thread_addon()) {
-                    network->get_main_thread_addon()->neuron_fired(timestamp, active_synapse, this, network);
-				}
-                
-                for (auto& axonTerminal : axon_terminals) {
-                    auto& post_synaptic_layer = network->get_layers()[network->get_neurons()[axonTerminal->get_postsynaptic_neuron_id()]->get_layer_id()];
-                    if (post_synaptic_layer.active) {
-                        network->inject_spike(spike{timestamp + axonTerminal->get_delay(), axonTerminal.get(), spike_type::generated});
-                    }
-                }
+                fire(timestamp, active_synapse, network);
+
+                reset_currents(timestamp);
 
-                request_learning(timestamp, active_synapse, this, network);
-                
-                if (wta) {
-                    winner_takes_all(timestamp, network);
-                }
-                
-				if (!bursting_activity) {
-                    for (auto& synapse: dendritic_tree) {
-                        synapse->reset();
-                    }
-				}
-                
                 potential = resting_potential;
                 previous_spike_time = timestamp;
 				active = false;
                 current = 0;
 			}
 		}
-		
+
+        // the synapse that last brought the neuron towards its threshold may have been pruned
+        virtual void synapses_pruned() override {
+            active_synapse = nullptr;
+        }
+
+        virtual bool integrates_lateral_inhibition() const override {
+            return true;
+        }
+
         virtual void reset_neuron(Network* network, bool clearAddons=true) override {
             previous_input_time = 0;
             previous_spike_time = 0;
             potential = resting_potential;
             trace = 0;
             current = 0;
-            
+
             for (auto& dendrite: dendritic_tree) {
                 dendrite->reset();
             }
-            
-            for (auto& axon_terminal: axon_terminals) {
-                axon_terminal->reset();
-            }
-            
+
             if (clearAddons) {
-                relevant_addons.clear();
+                clear_relevant_addons();
             }
         }
-        
+
+        virtual void serialise(state_archive& archive) override {
+            Neuron::serialise(archive);
+            features.serialise(archive);
+            archive(resting_threshold, decay_homeostasis, homeostasis_beta, refractory_counter, inv_trace_tau, inv_membrane_tau, inv_homeostasis_tau);
+        }
+
+        static std::string model_name() {
+            return Features::model_name();
+        }
+
 		// ----- SETTERS AND GETTERS -----
+        // only available with runtime features
         void set_wta(bool b) {
-            wta = b;
+            features.wta = b;
         }
-        
+
         void set_bursting_activity(bool new_bool) {
-            bursting_activity = new_bool;
+            features.bursting_activity = new_bool;
         }
-        
+
         void set_homeostasis(bool new_bool) {
-            homeostasis = new_bool;
+            features.homeostasis = new_bool;
         }
-        
+
         void set_resting_threshold(float new_thres) {
             resting_threshold = new_thres;
         }
-        
+
         void set_decay_homeostasis(float new_DH) {
             decay_homeostasis = new_DH;
+            inv_homeostasis_tau = 1. / new_DH;
         }
-        
+
         void set_homeostasis_beta(float new_HB) {
             homeostasis_beta = new_HB;
         }
-        
+
 	protected:
-		
+
+        basic_cuba_lif(Features _features, int _neuronID, int _layerID, int _sublayerID, int _rf_id,  std::pair<int, int> _xyCoordinates, int _refractoryPeriod, float _capacitance, float _leakageConductance, float _traceTimeConstant, float _decayHomeostasis, float _homeostasisBeta, float _threshold, float _restingPotential, int _classLabel) :
+                Neuron(_neuronID, _layerID, _sublayerID, _rf_id, _xyCoordinates, _refractoryPeriod, _capacitance, _leakageConductance, _traceTimeConstant, _threshold, _restingPotential, _classLabel),
+                features(_features),
+                resting_threshold(_threshold),
+                decay_homeostasis(_decayHomeostasis),
+                homeostasis_beta(_homeostasisBeta),
+                active_synapse(nullptr),
+                refractory_counter(0) {
+
+            inv_trace_tau = 1. / _traceTimeConstant;
+            inv_membrane_tau = 1./ membrane_time_constant;
+            inv_homeostasis_tau = 1. / _decayHomeostasis;
+        }
+
+        // firing logic shared by the event-based and clock-based updates
+        void fire(double timestamp, Synapse* s, Network* network) {
+            // save spikes on final LIF layer before the Decision Layer for classification purposes if there's a decision-making layer
+            if (features.decision_history && network->get_learning_status() && network->get_decision_making() && network->get_decision_parameters().layer_number == layer_id+1) {
+                network->get_decision_history().record(neuron_id, network->get_current_label());
+            }
+
+            trace = 1;
+
+            print_event(timestamp, s, network, "SPIKED");
+
+            for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
+                addon->neuron_fired(timestamp, s, this, network);
+            }
+
+            if (features.main_thread_addon && network->get_main_thread_addon()) {
+                network->get_main_thread_addon()->neuron_fired(timestamp, s, this, network);
+            }
+
+            for (auto& axonTerminal : axon_terminals) {
+                if (network->is_layer_active(axonTerminal->get_postsynaptic_layer_id())) {
+                    network->inject_spike(spike{timestamp + axonTerminal->get_delay(), axonTerminal.get(), spike_type::generated});
+                }
+            }
+
+            network->propagate_projections(timestamp, this);
+
+            request_learning(timestamp, s, this, network);
+
+            if (features.wta) {
+                winner_takes_all(timestamp, network);
+            }
+        }
+
+        void reset_currents(double timestamp) {
+            if (!features.bursting_activity) {
+                for (auto& synapse: dendritic_tree) {
+                    synapse->reset();
+                }
+                reset_lateral_inhibition(timestamp);
+            }
+        }
+
+        void gui_status_update(double timestamp, Network* network) {
+            if (features.main_thread_addon && network->get_main_thread_addon()) {
+                network->get_main_thread_addon()->status_update(timestamp, this, network);
+            }
+        }
+
+        void gui_incoming_spike(double timestamp, Synapse* s, Network* network) {
+            if (features.main_thread_addon && network->get_main_thread_addon()) {
+                network->get_main_thread_addon()->incoming_spike(timestamp, s, this, network);
+            }
+        }
+
+        void print_event(double timestamp, Synapse* s, Network* network, const char* event) {
+            if (features.verbose && network->get_verbose() == 2) {
+                std::cout << "t=" << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " w=" << s->get_weight() << " d=" << s->get_delay() <<" V=" << potential << " Vth=" << threshold << " layer=" << layer_id << " --> " << event << std::endl;
+            }
+        }
+
         // loops through any learning rules and activates them
         virtual void request_learning(double timestamp, Synapse* s, Neuron* postsynaptic_neuron, Network* network) override {
-            if (network->get_learning_status() && !relevant_addons.empty()) {
-                for (auto& addon: relevant_addons) {
+            if (network->get_learning_status() && !get_addons_for(addon_hook::learn).empty()) {
+                for (auto& addon: get_addons_for(addon_hook::learn)) {
                     addon->learn(timestamp, s, postsynaptic_neuron, network);
                 }
             }
         }
-        
+
         virtual void winner_takes_all(double timestamp, Network* network) override {
             for (auto& n: network->get_layers()[layer_id].neurons) {
                 auto& neuron = network->get_neurons()[n];
                 neuron->set_potential(resting_potential);
             }
         }
-        
+
 		// ----- LIF PARAMETERS -----
-        bool                         wta;
-		bool                         bursting_activity;
-		bool                         homeostasis;
+        Features                     features;
 		float                        resting_threshold;
 		float                        decay_homeostasis;
 		float                        homeostasis_beta;
 		Synapse*                     active_synapse;
         int                          refractory_counter;
-        
+
         // Parameters for performance improvement
         float                        inv_trace_tau;
         float                        inv_membrane_tau;
         float                        inv_homeostasis_tau;
 	};
+
+    using CUBA_LIF = basic_cuba_lif<runtime_features>;
+
+    template <typename Features = lif_features<>>
+    using Static_CUBA_LIF = basic_cuba_lif<Features>;
 }
@@ -24,22 +24,11 @@ namespace hummus {
                 Neuron(_neuronID, _layerID, _sublayerID, _rf_id, _xyCoordinates, 0, 200, 10, 20, _threshold, _restingPotential, _classLabel) {
         }
 
+		Decision_Making(Decision_Making&&) = default;
+
 		virtual ~Decision_Making(){}
 
         // ----- PUBLIC DECISION MAKING NEURON METHODS -----
-        virtual void initialisation(Network* network) override {
-            // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically relevant / not filtered out
-            for (auto& addon: network->get_addons()) {
-                if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                    add_relevant_addon(addon.get());
-                } else {
-                    if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                        add_relevant_addon(addon.get());
-                    }
-                }
-            }
-        }
-       
         virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
             
             if (type == spike_type::decision) {
@@ -50,7 +39,7 @@ namespace hummus {
                     std::cout << "t=" << timestamp << " class " << class_label << " --> DECISION" << std::endl;
                 }
 
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
                     addon->neuron_fired(timestamp, s, this, network);
                 }
 
@@ -79,7 +68,7 @@ namespace hummus {
             }
 
             if (clearAddons) {
-                relevant_addons.clear();
+                clear_relevant_addons();
             }
         }
 
@@ -87,6 +76,15 @@ namespace hummus {
             return static_cast<float>(intensity);
         }
 
+        virtual void serialise(state_archive& archive) override {
+            Neuron::serialise(archive);
+            archive(intensity);
+        }
+
+        static std::string model_name() {
+            return "Decision_Making";
+        }
+
     protected:
         
         void winner_takes_all(double timestamp, Network* network) override {
@@ -26,22 +26,11 @@ namespace hummus {
             inv_trace_tau = 1. / _traceTimeConstant;
         }
 		
+		Parrot(Parrot&&) = default;
+
 		virtual ~Parrot(){}
 		
 		// ----- PUBLIC INPUT NEURON METHODS -----
-        virtual void initialisation(Network* network) override {
-            // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically relevant / not filtered out
-            for (auto& addon: network->get_addons()) {
-                if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                    add_relevant_addon(addon.get());
-                } else {
-                    if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                        add_relevant_addon(addon.get());
-                    }
-                }
-            }
-        }
-        
         virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
             
             if (network->is_asynchronous()) {
@@ -68,7 +57,7 @@ namespace hummus {
                     std::cout << "t=" << timestamp << " " << neuron_id << " w=" << s->get_weight() << " d=" << s->get_delay() << " --> INPUT" << std::endl;
                 }
                 
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
                     addon->neuron_fired(timestamp, s, this, network);
                 }
                 
@@ -77,19 +66,20 @@ namespace hummus {
                 }
                 
                 for (auto& axonTerminal : axon_terminals) {
-                    auto& post_synaptic_layer = network->get_layers()[network->get_neurons()[axonTerminal->get_postsynaptic_neuron_id()]->get_layer_id()];
-                    if (post_synaptic_layer.active) {
+                    if (network->is_layer_active(axonTerminal->get_postsynaptic_layer_id())) {
                         network->inject_spike(spike{timestamp + axonTerminal->get_delay(), axonTerminal.get(), spike_type::generated});
                     }
                 }
                 
+                network->propagate_projections(timestamp, this);
+                
                 request_learning(timestamp, s, this, network);
                 
                 if (network->get_main_thread_addon()) {
                     network->get_main_thread_addon()->status_update(timestamp, this, network);
                 }
                 
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::status_update)) {
                     addon->status_update(timestamp, this, network);
                 }
                 
@@ -104,19 +94,28 @@ namespace hummus {
                         network->get_main_thread_addon()->status_update(timestamp, this, network);
                     }
                     
-                    for (auto& addon: relevant_addons) {
+                    for (auto& addon: get_addons_for(addon_hook::status_update)) {
                         addon->status_update(timestamp, this, network);
                     }
                 }
             }
 		}
         
+        virtual void serialise(state_archive& archive) override {
+            Neuron::serialise(archive);
+            archive(inv_trace_tau);
+        }
+
+        static std::string model_name() {
+            return "Parrot";
+        }
+
     protected:
         
         // loops through any learning rules and activates them
         virtual void request_learning(double timestamp, Synapse* s, Neuron* postsynapticNeuron, Network* network) override {
             if (network->get_learning_status()) {
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::learn)) {
                     addon->learn(timestamp, s, postsynapticNeuron, network);
                 }
             }
@@ -86,17 +86,6 @@ namespace hummus {
 
         // ----- PUBLIC REGRESSION NEURON METHODS -----
         virtual void initialisation(Network* network) override {
-           // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically relevant / not filtered out
-           for (auto& addon: network->get_addons()) {
-               if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                   add_relevant_addon(addon.get());
-               } else {
-                   if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                       add_relevant_addon(addon.get());
-                   }
-               }
-           }
-           
            if (computation_layer) {
                auto& previous_layer_neurons = network->get_layers()[layer_id-1].neurons;
                
@@ -232,7 +221,7 @@ namespace hummus {
                         std::cout << "t=" << timestamp << " class " << class_label << " --> DECISION" << std::endl;
                     }
 
-                    for (auto& addon: relevant_addons) {
+                    for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
                         addon->neuron_fired(timestamp, s, this, network);
                     }
 
@@ -251,7 +240,7 @@ namespace hummus {
         // reset a neuron to its initial status
         virtual void reset_neuron(Network* network, bool clearAddons=true) override {
             if (clearAddons) {
-                relevant_addons.clear();
+                clear_relevant_addons();
             }
             
             x_online = torch::zeros(number_of_output_neurons);
@@ -401,6 +390,7 @@ namespace hummus {
             for (auto& n: decision) {
                 auto& neuron = network->get_neurons()[n];
                 if (neuron->get_class_label() == class_label) {
+                    network->touch_neuron(n);
                     neuron->update(timestamp, nullptr, network, timestep, spike_type::decision);
                 }
             }
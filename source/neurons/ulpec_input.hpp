@@ -28,22 +28,11 @@ namespace hummus {
             membrane_time_constant = _tau;
         }
 
+        ULPEC_Input(ULPEC_Input&&) = default;
+
         virtual ~ULPEC_Input(){}
 
         // ----- PUBLIC INPUT NEURON METHODS -----
-        virtual void initialisation(Network* network) override {
-            // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically relevant / not filtered out
-            for (auto& addon: network->get_addons()) {
-                if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                    add_relevant_addon(addon.get());
-                } else {
-                    if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                        add_relevant_addon(addon.get());
-                    }
-                }
-            }
-        }
-
         virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
             
             // updating GUI values status before any computation
@@ -70,7 +59,7 @@ namespace hummus {
                 }
                 
                 // send neuron_fired signal to the addons
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
                     addon->neuron_fired(timestamp, s, this, network);
                 }
 
@@ -89,6 +78,15 @@ namespace hummus {
             }
         }
 
+        virtual void serialise(state_archive& archive) override {
+            Neuron::serialise(archive);
+            archive(injected_potential);
+        }
+
+        static std::string model_name() {
+            return "ULPEC_Input";
+        }
+
     protected:
         
         // ----- PULSE_GENERATOR PARAMETERS -----
@@ -35,22 +35,11 @@ namespace hummus {
                 skip_after_post(_skip_after_post) {
         }
 		
+		ULPEC_LIF(ULPEC_LIF&&) = default;
+
 		virtual ~ULPEC_LIF(){}
 		
 		// ----- PUBLIC INPUT NEURON METHODS -----
-        virtual void initialisation(Network* network) override {
-            // searching for addons that are relevant to this neuron. if addons do not have a mask they are automatically relevant / not filtered out
-            for (auto& addon: network->get_addons()) {
-                if (addon->get_mask().empty() && !addon->no_automatic_include()) {
-                    add_relevant_addon(addon.get());
-                } else {
-                    if (auto it = std::find(addon->get_mask().begin(), addon->get_mask().end(), static_cast<size_t>(neuron_id)); it != addon->get_mask().end()) {
-                        add_relevant_addon(addon.get());
-                    }
-                }
-            }
-        }
-        
         virtual void update(double timestamp, Synapse* s, Network* network, float timestep, spike_type type) override {
             // during testing there is no refractory period
             if (!network->get_learning_status() && refractory_period != 0) {
@@ -122,7 +111,7 @@ namespace hummus {
                 s->receive_spike(2*delta_v);
 
             } else if (type == spike_type::end_trigger_up) {
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::incoming_spike)) {
                     addon->incoming_spike(timestamp, s, this, network);
                 }
                 
@@ -131,7 +120,7 @@ namespace hummus {
                 
             } else if (type == spike_type::end_trigger_down) {
                 
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::incoming_spike)) {
                     addon->incoming_spike(timestamp, s, this, network);
                 }
                 
@@ -158,15 +147,20 @@ namespace hummus {
                 dendrite->reset();
             }
 
-            for (auto& axon_terminal: axon_terminals) {
-                axon_terminal->reset();
-            }
-
             if (clearAddons) {
-                relevant_addons.clear();
+                clear_relevant_addons();
             }
         }
         
+        virtual void serialise(state_archive& archive) override {
+            Neuron::serialise(archive);
+            archive(epsilon, i_discharge, scaling_factor, potentiation_flag, tau_up, tau_down_event, tau_down_spike, refractory_counter, delta_v, skip_after_post);
+        }
+
+        static std::string model_name() {
+            return "ULPEC_LIF";
+        }
+
     protected:
         
         // computing the neuron's current
@@ -216,7 +210,7 @@ namespace hummus {
                 std::cout << "t " << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " i_z " << current << " v_mem " << potential << " layer id " << layer_id << std::endl;
             }
 
-            for (auto& addon: relevant_addons) {
+            for (auto& addon: get_addons_for(addon_hook::incoming_spike)) {
                 addon->incoming_spike(timestamp, s, this, network);
             }
 
@@ -231,19 +225,14 @@ namespace hummus {
                 
                 // save spikes on the LIF layer before the Decision Layer for classification purposes if there's a decision-making layer
                 if (network->get_learning_status() && network->get_decision_making() && network->get_decision_parameters().layer_number == layer_id+1) {
-                    if (static_cast<int>(decision_queue.size()) < network->get_decision_parameters().spike_history_size) {
-                        decision_queue.emplace_back(network->get_current_label());
-                    } else {
-                        decision_queue.pop_front();
-                        decision_queue.emplace_back(network->get_current_label());
-                    }
+                    network->get_decision_history().record(neuron_id, network->get_current_label());
                 }
                 
                 if (network->get_verbose() == 2) {
                     std::cout << "t " << timestamp << " " << s->get_presynaptic_neuron_id() << "->" << neuron_id << " i_z " << current << " v_mem " << potential << " layer id " << layer_id << " --> SPIKED" << std::endl;
                 }
                 
-                for (auto& addon: relevant_addons) {
+                for (auto& addon: get_addons_for(addon_hook::neuron_fired)) {
                     addon->neuron_fired(timestamp, s, this, network);
                 }
                 
@@ -253,8 +242,7 @@ namespace hummus {
                 
                 // propagate spike through the axon terminals (towards decision-making neurons)
                 for (auto& axon_terminal : axon_terminals) {
-                    auto& postsynaptic_layer = network->get_layers()[network->get_neurons()[axon_terminal->get_postsynaptic_neuron_id()]->get_layer_id()];
-                    if (postsynaptic_layer.active) {
+                    if (network->is_layer_active(axon_terminal->get_postsynaptic_layer_id())) {
                         network->inject_spike(spike{timestamp, axon_terminal.get(), spike_type::generated});
                     }
                 }
@@ -332,6 +320,7 @@ namespace hummus {
         void winner_takes_all(double timestamp, Network* network) override {
             for (auto& n: network->get_layers()[layer_id].neurons) {
                 auto& neuron = network->get_neurons()[n];
+                network->touch_neuron(n); // the soft wta changes neurons that did not receive anything
 //                neuron->set_potential(resting_potential);
                 if (neuron->get_rf_id() == rf_id) {
                     neuron->set_potential(resting_potential); // hard wta
@@ -344,8 +333,8 @@ namespace hummus {
         
         // loops through any learning rules and activates them
         virtual void request_learning(double timestamp, Synapse* s, Neuron* postsynapticNeuron, Network* network) override {
-            if (network->get_learning_status() && !relevant_addons.empty()) {
-                for (auto& addon: relevant_addons) {
+            if (network->get_learning_status() && !get_addons_for(addon_hook::learn).empty()) {
+                for (auto& addon: get_addons_for(addon_hook::learn)) {
                     addon->learn(timestamp, s, postsynapticNeuron, network);
                 }
             }
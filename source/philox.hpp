@@ -0,0 +1,94 @@
+/*
+ * philox.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Philox4x32-10 counter-based random number generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3", SC 2011). Every output block is a pure function of a 64-bit key and a 128-bit counter, so independent streams can be opened anywhere (e.g. one per synapse) without sharing state between threads. The class satisfies UniformRandomBitGenerator and can be passed to the std distributions and to the classes of the random_distributions folder.
+ */
+
+#pragma once
+
+#include <array>
+#include <limits>
+#include <cstdint>
+
+namespace hummus {
+
+    class philox_engine {
+
+    public:
+
+        using result_type = std::uint32_t;
+
+        // ----- CONSTRUCTOR -----
+        // the three counter words select the stream, the fourth one counts the blocks drawn from it
+        philox_engine(std::uint64_t _key, std::uint32_t _stream0=0, std::uint32_t _stream1=0, std::uint32_t _stream2=0) :
+                key{static_cast<std::uint32_t>(_key), static_cast<std::uint32_t>(_key >> 32)},
+                counter{_stream0, _stream1, _stream2, 0},
+                block{},
+                position(4) {}
+
+        // ----- PUBLIC METHODS -----
+        static constexpr result_type min() {
+            return 0;
+        }
+
+        static constexpr result_type max() {
+            return std::numeric_limits<result_type>::max();
+        }
+
+        result_type operator()() {
+            if (position == 4) {
+                block = generate(counter, key);
+                ++counter[3];
+                position = 0;
+            }
+            return block[position++];
+        }
+
+        void discard(unsigned long long n) {
+            for (; n > 0; --n) {
+                operator()();
+            }
+        }
+
+        // ten rounds of the Philox4x32 bijection
+        static std::array<std::uint32_t, 4> generate(std::array<std::uint32_t, 4> ctr, std::array<std::uint32_t, 2> k) {
+            for (int round=0; round<10; ++round) {
+                const std::uint64_t product0 = static_cast<std::uint64_t>(multiplier0) * ctr[0];
+                const std::uint64_t product1 = static_cast<std::uint64_t>(multiplier1) * ctr[2];
+                ctr = {static_cast<std::uint32_t>(product1 >> 32) ^ ctr[1] ^ k[0],
+                       static_cast<std::uint32_t>(product1),
+                       static_cast<std::uint32_t>(product0 >> 32) ^ ctr[3] ^ k[1],
+                       static_cast<std::uint32_t>(product0)};
+                k[0] += weyl0;
+                k[1] += weyl1;
+            }
+            return ctr;
+        }
+
+        // splitmix64 finaliser, used to turn a seed and a small index into a well-mixed key
+        static std::uint64_t mix(std::uint64_t x) {
+            x += 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        static constexpr std::uint32_t multiplier0 = 0xD2511F53;
+        static constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+        static constexpr std::uint32_t weyl0       = 0x9E3779B9;
+        static constexpr std::uint32_t weyl1       = 0xBB67AE85;
+
+        std::array<std::uint32_t, 2>   key;
+        std::array<std::uint32_t, 4>   counter;
+        std::array<std::uint32_t, 4>   block;
+        int                            position;
+    };
+}
@@ -0,0 +1,140 @@
+/*
+ * prefetcher.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Bounded queue filled by background threads. The items of a database are loaded in advance, at most depth of them ahead of the one being consumed, and handed back in the order of the database. Used by run_es_database and run_npy_database so the simulation thread does not wait on the disk while the loaders keep up.
+ *
+ * Usage: hummus::prefetcher<std::vector<double>> files(database.size(), [&](std::size_t i) { return load(database[i]); }); auto data = files.next();
+ */
+
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <functional>
+#include <condition_variable>
+
+namespace hummus {
+
+    template <typename T>
+    class prefetcher {
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        // load(i) is called once for every i in [0, count) on the loading threads, so it must not touch the state of the network
+        prefetcher(std::size_t _count, std::function<T(std::size_t)> _load, std::size_t _depth=4, std::size_t thread_count=1) :
+                count(_count),
+                load(std::move(_load)),
+                depth(std::max<std::size_t>(_depth, 1)),
+                slots(depth),
+                next_load(0),
+                next_item(0),
+                stopping(false) {
+
+            thread_count = std::min(std::max<std::size_t>(thread_count, 1), std::min(depth, count));
+            for (std::size_t t=0; t<thread_count; ++t) {
+                workers.emplace_back([this]() {
+                    work();
+                });
+            }
+        }
+
+        prefetcher(const prefetcher&) = delete;
+        prefetcher& operator=(const prefetcher&) = delete;
+
+        // the items being loaded are finished, the others are never started
+        ~prefetcher() {
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                stopping = true;
+            }
+            space_available.notify_all();
+            for (auto& worker: workers) {
+                worker.join();
+            }
+        }
+
+        // ----- PUBLIC METHODS -----
+        // takes the next item out of the queue, waiting only if it is not loaded yet. an exception thrown while loading it is rethrown here
+        T next() {
+            if (next_item >= count) {
+                throw std::logic_error("every item of the prefetcher was already consumed");
+            }
+
+            std::unique_lock<std::mutex> lock(mutex);
+            auto& s = slots[next_item % depth];
+            item_loaded.wait(lock, [&]() { return s.ready; });
+
+            auto error = std::move(s.error);
+            std::optional<T> value = std::move(s.value);
+            s = slot{};
+            ++next_item;
+            lock.unlock();
+            space_available.notify_all();
+
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return std::move(*value);
+        }
+
+    protected:
+
+        struct slot {
+            std::optional<T>       value;
+            std::exception_ptr     error;
+            bool                   ready = false;
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        // item i goes into the slot of item i-depth, which has been consumed once next_item passed it
+        void work() {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (true) {
+                space_available.wait(lock, [&]() { return stopping || next_load >= count || next_load < next_item + depth; });
+                if (stopping || next_load >= count) {
+                    return;
+                }
+                auto i = next_load++;
+                lock.unlock();
+
+                slot loaded;
+                try {
+                    loaded.value.emplace(load(i));
+                } catch (...) {
+                    loaded.error = std::current_exception();
+                }
+                loaded.ready = true;
+
+                lock.lock();
+                slots[i % depth] = std::move(loaded);
+                item_loaded.notify_all();
+            }
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        std::size_t                               count;
+        std::function<T(std::size_t)>             load;
+        std::size_t                               depth;
+        std::vector<slot>                         slots; // ring buffer of the items loaded ahead
+        std::size_t                               next_load; // next item handed to a loading thread
+        std::size_t                               next_item; // next item returned by next
+        bool                                      stopping;
+        std::mutex                                mutex;
+        std::condition_variable                   item_loaded;
+        std::condition_variable                   space_available;
+        std::vector<std::thread>                  workers;
+    };
+}
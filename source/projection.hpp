@@ -0,0 +1,137 @@
+/*
+ * projection.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: The Projection class is a polymorphic class for connections between two layers that are computed when a neuron fires instead of being stored as one synapse per connection. Each postsynaptic neuron gets a single port synapse per projection. Spikes sent through a port carry their presynaptic neuron, and the port takes the weight of that connection just before the postsynaptic neuron integrates it.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "synapse.hpp"
+
+namespace hummus {
+    class Synapse;
+    class Neuron;
+    class Network;
+
+    // polymorphic class for implicit connections between two layers
+    class Projection {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        Projection(Network* _network, int _presynaptic_layer, int _postsynaptic_layer) :
+                network(_network),
+                presynaptic_layer(_presynaptic_layer),
+                postsynaptic_layer(_postsynaptic_layer) {}
+
+        virtual ~Projection(){}
+
+        // ----- PUBLIC METHODS -----
+
+        // injects the spikes of a neuron of the presynaptic layer that just fired
+        virtual void propagate(double timestamp, int presynaptic_neuron) = 0;
+
+        // weight of the connection between a presynaptic neuron and the postsynaptic neuron of a port, read when a spike is delivered
+        virtual float get_weight(int presynaptic_neuron, std::size_t port) const = 0;
+
+        // updates the neuron indices held by the projection after Network::reorder_neurons
+        virtual void relabel_neurons(const std::vector<std::size_t>& new_indices) {
+            for (auto& port: ports) {
+                port->set_postsynaptic_neuron_id(static_cast<int>(new_indices[port->get_postsynaptic_neuron_id()]));
+                port->set_presynaptic_neuron_id(static_cast<int>(new_indices[port->get_presynaptic_neuron_id()]));
+            }
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        int get_presynaptic_layer_id() const {
+            return presynaptic_layer;
+        }
+
+        int get_postsynaptic_layer_id() const {
+            return postsynaptic_layer;
+        }
+
+        Synapse* get_port(std::size_t port) const {
+            return ports[port].get();
+        }
+
+        std::size_t get_number_of_ports() const {
+            return ports.size();
+        }
+
+        // longest delay of the projection, used to shift the runtime in the clock mode
+        virtual float get_max_delay() const {
+            return 0;
+        }
+
+        // bytes used by the projection and its ports. derived projections add the tables they own
+        virtual std::size_t get_memory_footprint() const {
+            std::size_t bytes = ports.capacity() * sizeof(std::unique_ptr<Synapse>);
+            for (auto& port: ports) {
+                bytes += port->get_memory_footprint();
+            }
+            return bytes;
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+
+        // adds the port of the next postsynaptic neuron to its dendritic tree. presynaptic_neuron is any neuron connected to it, so the port is valid before it receives its first spike
+        template <typename T, typename N, typename... Args>
+        Synapse* make_port(N* postsynaptic_neuron, int presynaptic_neuron, float weight, float delay, Args&&... args);
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        Network*                                  network;
+        int                                       presynaptic_layer;
+        int                                       postsynaptic_layer;
+        std::vector<std::unique_ptr<Synapse>>     ports; // one per postsynaptic neuron, in the order of the postsynaptic layer
+    };
+
+    // synapse standing for every connection of a projection that ends on one postsynaptic neuron. it keeps the dynamics of the synapse model T
+    template <typename T>
+    class projection_port : public T {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        template <typename... Args>
+        projection_port(const Projection* _projection, std::size_t _port, int _postsynaptic_neuron, int _presynaptic_neuron, float _weight, float _delay, Args&&... args) :
+                T(_postsynaptic_neuron, _presynaptic_neuron, _weight, _delay, static_cast<float>(std::forward<Args>(args))...),
+                projection(_projection),
+                port(_port) {}
+
+        virtual ~projection_port(){}
+
+        // ----- PUBLIC METHODS -----
+        virtual void route_from(int presynaptic_neuron) override {
+            this->presynaptic_neuron = presynaptic_neuron;
+            this->weight = projection->get_weight(presynaptic_neuron, port);
+            this->type = this->weight < 0 ? synapse_type::inhibitory : synapse_type::excitatory;
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        virtual std::size_t get_memory_footprint() const override {
+            return sizeof(projection_port);
+        }
+
+    protected:
+        const Projection*                         projection;
+        std::size_t                               port;
+    };
+
+    template <typename T, typename N, typename... Args>
+    Synapse* Projection::make_port(N* postsynaptic_neuron, int presynaptic_neuron, float weight, float delay, Args&&... args) {
+        ports.emplace_back(new projection_port<T>(this, ports.size(), postsynaptic_neuron->get_neuron_id(), presynaptic_neuron, weight, delay, std::forward<Args>(args)...));
+        ports.back()->set_postsynaptic_layer_id(postsynaptic_layer);
+        postsynaptic_neuron->get_dendritic_tree().emplace_back(ports.back().get());
+        return ports.back().get();
+    }
+}
@@ -0,0 +1,257 @@
+/*
+ * convolution.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Weight-shared convolution between two grid layers. Instead of one synapse per (presynaptic neuron, postsynaptic neuron, kernel position), each postsynaptic sublayer keeps one kernel of weights and delays per presynaptic sublayer, and the neurons reached by a spike are computed from its coordinates, the stride and the kernel size. The kernel can be trained with the KernelSTDP learning rule.
+ *
+ * Usage: auto& conv_projection = network.make_projection<hummus::ConvolutionProjection<hummus::Exponential>>(input, conv, hummus::Normal(0.6, 0.1, 1, 0.5), 10, 80);
+ */
+
+#pragma once
+
+#include <random>
+#include <cstdint>
+#include <stdexcept>
+#include <algorithm>
+
+#include "../core.hpp"
+
+namespace hummus {
+
+    // shared kernels sliding over a presynaptic grid layer. every output position of a postsynaptic sublayer reads a kernel_size x kernel_size window starting at (stride * column, stride * row)
+    class KernelProjection : public Projection {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        // depthwise kernels only connect sublayers with the same index, otherwise every postsynaptic sublayer has one kernel per presynaptic sublayer
+        KernelProjection(Network& _network, const layer& presynapticLayer, const layer& postsynapticLayer, int _kernel_size, int _stride, bool _depthwise) :
+                Projection(&_network, presynapticLayer.id, postsynapticLayer.id),
+                kernel_size(_kernel_size),
+                stride(_stride),
+                depthwise(_depthwise),
+                pre_width(presynapticLayer.width),
+                pre_height(presynapticLayer.height),
+                post_width(postsynapticLayer.width),
+                post_height(postsynapticLayer.height),
+                pre_sublayers(static_cast<int>(presynapticLayer.sublayers.size())),
+                post_sublayers(static_cast<int>(postsynapticLayer.sublayers.size())),
+                pre_first(presynapticLayer.neurons.first),
+                post_first(postsynapticLayer.neurons.first),
+                max_delay(0) {
+
+            // error handling
+            if (pre_width <= 0 || pre_height <= 0 || post_width <= 0 || post_height <= 0) {
+                throw std::logic_error("kernel projections connect grid layers, build both layers with make_grid");
+            }
+
+            if (kernel_size <= 0 || stride <= 0 || stride * (post_width - 1) + kernel_size > pre_width || stride * (post_height - 1) + kernel_size > pre_height) {
+                throw std::logic_error("the kernel does not fit in the presynaptic layer");
+            }
+
+            if (depthwise && pre_sublayers != post_sublayers) {
+                throw std::logic_error("depthwise kernels need the same number of sublayers in both layers");
+            }
+
+            auto kernel_entries = static_cast<std::size_t>(post_sublayers) * inputs_per_kernel() * kernel_size * kernel_size;
+            weights.resize(kernel_entries, 0);
+            delays.resize(kernel_entries, 0);
+        }
+
+        virtual ~KernelProjection(){}
+
+        // ----- PUBLIC METHODS -----
+        virtual void propagate(double timestamp, int presynaptic_neuron) override {
+            for_each_target(presynaptic_neuron, [&](std::size_t port, std::size_t kernel_idx) {
+                network->inject_spike(spike{timestamp + delays[kernel_idx], ports[port].get(), spike_type::generated, presynaptic_neuron});
+            });
+        }
+
+        virtual float get_weight(int presynaptic_neuron, std::size_t port) const override {
+            auto pre = presynaptic_position(presynaptic_neuron);
+            int post_sub = static_cast<int>(port / post_area());
+            int row = static_cast<int>(port % post_area()) / post_width;
+            int column = static_cast<int>(port % post_area()) % post_width;
+            return weights[kernel_index(post_sub, pre.sublayer, pre.x - stride * column, pre.y - stride * row)];
+        }
+
+        // calls f(port, kernel index) for every postsynaptic neuron whose window contains the presynaptic neuron
+        template <typename F>
+        void for_each_target(int presynaptic_neuron, F&& f) const {
+            auto pre = presynaptic_position(presynaptic_neuron);
+
+            // windows [stride * c, stride * c + kernel_size) containing x
+            int first_column = pre.x < kernel_size ? 0 : (pre.x - kernel_size + stride) / stride;
+            int last_column = std::min(post_width - 1, pre.x / stride);
+            int first_row = pre.y < kernel_size ? 0 : (pre.y - kernel_size + stride) / stride;
+            int last_row = std::min(post_height - 1, pre.y / stride);
+
+            int first_sub = depthwise ? pre.sublayer : 0;
+            int last_sub = depthwise ? pre.sublayer : post_sublayers - 1;
+            for (int post_sub=first_sub; post_sub<=last_sub; ++post_sub) {
+                for (int row=first_row; row<=last_row; ++row) {
+                    for (int column=first_column; column<=last_column; ++column) {
+                        f(post_sub * post_area() + static_cast<std::size_t>(row * post_width + column), kernel_index(post_sub, pre.sublayer, pre.x - stride * column, pre.y - stride * row));
+                    }
+                }
+            }
+        }
+
+        // calls f(presynaptic neuron index, kernel index) for every presynaptic neuron in the window of a port
+        template <typename F>
+        void for_each_source(std::size_t port, F&& f) const {
+            int post_sub = static_cast<int>(port / post_area());
+            int row = static_cast<int>(port % post_area()) / post_width;
+            int column = static_cast<int>(port % post_area()) % post_width;
+
+            int first_sub = depthwise ? post_sub : 0;
+            int last_sub = depthwise ? post_sub : pre_sublayers - 1;
+            for (int pre_sub=first_sub; pre_sub<=last_sub; ++pre_sub) {
+                for (int ky=0; ky<kernel_size; ++ky) {
+                    for (int kx=0; kx<kernel_size; ++kx) {
+                        auto user_id = pre_first + pre_sub * pre_area() + static_cast<std::size_t>((stride * row + ky) * pre_width + stride * column + kx);
+                        f(network->get_neuron_index(static_cast<int>(user_id)), kernel_index(post_sub, pre_sub, kx, ky));
+                    }
+                }
+            }
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        int get_kernel_size() const {
+            return kernel_size;
+        }
+
+        int get_stride() const {
+            return stride;
+        }
+
+        bool is_depthwise() const {
+            return depthwise;
+        }
+
+        // kernels stored as [postsynaptic sublayer][presynaptic sublayer][row][column]. a single presynaptic sublayer for depthwise kernels
+        std::vector<float>& get_weights() {
+            return weights;
+        }
+
+        std::vector<float>& get_delays() {
+            return delays;
+        }
+
+        virtual float get_max_delay() const override {
+            return max_delay;
+        }
+
+        virtual std::size_t get_memory_footprint() const override {
+            return sizeof(KernelProjection) + Projection::get_memory_footprint() + (weights.capacity() + delays.capacity()) * sizeof(float);
+        }
+
+    protected:
+
+        struct grid_position {
+            int sublayer;
+            int x;
+            int y;
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        std::size_t pre_area() const {
+            return static_cast<std::size_t>(pre_width) * pre_height;
+        }
+
+        std::size_t post_area() const {
+            return static_cast<std::size_t>(post_width) * post_height;
+        }
+
+        std::size_t inputs_per_kernel() const {
+            return depthwise ? 1 : static_cast<std::size_t>(pre_sublayers);
+        }
+
+        std::size_t kernel_index(int post_sub, int pre_sub, int kx, int ky) const {
+            return ((post_sub * inputs_per_kernel() + (depthwise ? 0 : pre_sub)) * kernel_size + ky) * kernel_size + kx;
+        }
+
+        // sublayer and coordinates of a presynaptic neuron, found from the id it was given at construction
+        grid_position presynaptic_position(int presynaptic_neuron) const {
+            auto local = static_cast<std::size_t>(network->get_user_id(presynaptic_neuron)) - pre_first;
+            int position = static_cast<int>(local % pre_area());
+            return grid_position{static_cast<int>(local / pre_area()), position % pre_width, position / pre_width};
+        }
+
+        // draws every kernel entry. lambdaFunction receives the coordinates inside the kernel and the postsynaptic sublayer
+        template <typename F>
+        void draw_kernels(F& lambdaFunction) {
+            auto draw = [&](auto& engine) {
+                for (std::size_t k=0; k<weights.size(); ++k) {
+                    int kx = static_cast<int>(k % kernel_size);
+                    int ky = static_cast<int>((k / kernel_size) % kernel_size);
+                    int post_sub = static_cast<int>(k / (kernel_size * kernel_size * inputs_per_kernel()));
+                    const std::pair<float, float> weight_delay = lambdaFunction(kx, ky, post_sub, engine);
+                    weights[k] = weight_delay.first;
+                    delays[k] = weight_delay.second;
+                    max_delay = std::max(max_delay, weight_delay.second);
+                }
+            };
+
+            // seeded networks get the same kernels for the same seed, the others draw from the random engine of the network like the layer connection methods
+            if (network->is_construction_seeded()) {
+                philox_engine engine(philox_engine::mix(network->get_construction_seed()), static_cast<std::uint32_t>(presynaptic_layer), static_cast<std::uint32_t>(postsynaptic_layer));
+                draw(engine);
+            } else {
+                draw(network->get_random_engine());
+            }
+        }
+
+        // one port per postsynaptic neuron. also gives the presynaptic neurons the id of the last window containing them, like Network::convolution
+        template <typename T, typename... Args>
+        void make_ports(Args&&... args) {
+            for (std::size_t port=0; port<static_cast<std::size_t>(post_sublayers) * post_area(); ++port) {
+                auto& neuron = network->get_neurons()[network->get_neuron_index(static_cast<int>(post_first + port))];
+                int first_source = network->get_neuron_index(static_cast<int>(pre_first + (depthwise ? (port / post_area()) * pre_area() : 0) + static_cast<std::size_t>(stride * static_cast<int>((port % post_area()) / post_width) * pre_width + stride * static_cast<int>((port % post_area()) % post_width))));
+                make_port<T>(neuron.get(), first_source, weights[0], delays[0], args...);
+            }
+
+            for (std::size_t local=0; local<static_cast<std::size_t>(pre_sublayers) * pre_area(); ++local) {
+                int position = static_cast<int>(local % pre_area());
+                int last_column = std::min(post_width - 1, (position % pre_width) / stride);
+                int last_row = std::min(post_height - 1, (position / pre_width) / stride);
+                network->get_neurons()[network->get_neuron_index(static_cast<int>(pre_first + local))]->set_rf_id(last_row * post_width + last_column);
+            }
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        int                                       kernel_size;
+        int                                       stride;
+        bool                                      depthwise;
+        int                                       pre_width;
+        int                                       pre_height;
+        int                                       post_width;
+        int                                       post_height;
+        int                                       pre_sublayers;
+        int                                       post_sublayers;
+        std::size_t                               pre_first; // id given at construction to the first neuron of each layer
+        std::size_t                               post_first;
+        float                                     max_delay;
+        std::vector<float>                        weights;
+        std::vector<float>                        delays;
+    };
+
+    // convolution using the kernel size and stride the postsynaptic layer was built with (see Network::make_grid). lambdaFunction: takes in either a lambda function (operating on the coordinates inside the kernel and the postsynaptic sublayer) or one of the classes inside the randomDistributions folder to define a distribution for the kernel weights and delays. The last parameters characterise the synapse model T of the ports
+    template <typename T = Synapse>
+    class ConvolutionProjection : public KernelProjection {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        template <typename F, typename... Args>
+        ConvolutionProjection(Network& _network, const layer& presynapticLayer, const layer& postsynapticLayer, F&& lambdaFunction, Args&&... args) :
+                KernelProjection(_network, presynapticLayer, postsynapticLayer, postsynapticLayer.kernel_size, postsynapticLayer.stride, false) {
+            draw_kernels(lambdaFunction);
+            make_ports<T>(std::forward<Args>(args)...);
+        }
+
+        virtual ~ConvolutionProjection(){}
+    };
+}
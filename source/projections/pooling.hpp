@@ -0,0 +1,65 @@
+/*
+ * pooling.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Implicit pooling between a grid layer and the layer built from it with Network::make_subsampled_grid. A presynaptic spike goes to the pooling neuron of the same sublayer at its coordinates divided by the subsampling factor, with either one shared weight and delay or a weight and delay per offset inside the pooling window.
+ *
+ * Usage: network.make_projection<hummus::PoolingProjection<hummus::Exponential>>(conv, pool, std::make_pair(1.f, 0.f), 10, 100);
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "convolution.hpp"
+
+namespace hummus {
+
+    template <typename T = Synapse>
+    class PoolingProjection : public KernelProjection {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        // one weight and delay per offset and sublayer. lambdaFunction: takes in either a lambda function (operating on the offset inside the pooling window and the sublayer) or one of the classes inside the randomDistributions folder. The last parameters characterise the synapse model T of the ports
+        template <typename F, typename... Args>
+        PoolingProjection(Network& _network, const layer& presynapticLayer, const layer& postsynapticLayer, F&& lambdaFunction, Args&&... args) :
+                KernelProjection(_network, presynapticLayer, postsynapticLayer, subsampling_factor(presynapticLayer, postsynapticLayer), subsampling_factor(presynapticLayer, postsynapticLayer), true) {
+            draw_kernels(lambdaFunction);
+            make_ports<T>(std::forward<Args>(args)...);
+        }
+
+        // the same weight and delay for the whole pooling window
+        template <typename... Args>
+        PoolingProjection(Network& _network, const layer& presynapticLayer, const layer& postsynapticLayer, std::pair<float, float> weight_delay, Args&&... args) :
+                PoolingProjection(_network, presynapticLayer, postsynapticLayer, [weight_delay](int, int, int, auto&) { return weight_delay; }, std::forward<Args>(args)...) {}
+
+        virtual ~PoolingProjection(){}
+
+        // ----- PUBLIC METHODS -----
+        // windows don't overlap, so every presynaptic neuron reaches at most one pooling neuron
+        virtual void propagate(double timestamp, int presynaptic_neuron) override {
+            auto pre = presynaptic_position(presynaptic_neuron);
+            int column = pre.x / stride;
+            int row = pre.y / stride;
+            if (column < post_width && row < post_height) {
+                auto port = pre.sublayer * post_area() + static_cast<std::size_t>(row * post_width + column);
+                auto kernel_idx = kernel_index(pre.sublayer, 0, pre.x - stride * column, pre.y - stride * row);
+                network->inject_spike(spike{timestamp + delays[kernel_idx], ports[port].get(), spike_type::generated, presynaptic_neuron});
+            }
+        }
+
+    protected:
+
+        // ----- IMPLEMENTATION METHODS -----
+        static int subsampling_factor(const layer& presynapticLayer, const layer& postsynapticLayer) {
+            if (postsynapticLayer.width <= 0 || postsynapticLayer.height <= 0 || presynapticLayer.width / postsynapticLayer.width != presynapticLayer.height / postsynapticLayer.height) {
+                throw std::logic_error("the postsynaptic layer is not a subsampled version of the presynaptic layer");
+            }
+            return presynapticLayer.width / postsynapticLayer.width;
+        }
+    };
+}
@@ -0,0 +1,163 @@
+/*
+ * procedural.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Procedural all-to-all connectivity. The targets, weights and delays of a neuron are regenerated from counter-based random streams every time it fires, so nothing is stored per connection: only one port per postsynaptic neuron. Connecting a layer to itself gives a reservoir without self-excitation. The weights are fixed by the distribution and cannot learn.
+ *
+ * Usage: network.make_projection<hummus::ProceduralProjection<hummus::Exponential>>(reservoir, reservoir, hummus::Normal(0.5, 0.2, 1, 0.5), 10, 10, 100);
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../core.hpp"
+
+namespace hummus {
+
+    // lambdaFunction: takes in either a lambda function (operating on the coordinates and sublayer of the postsynaptic neuron) or one of the classes inside the randomDistributions folder. every connection is kept with a probability of connection_ratio %. The last parameters characterise the synapse model T of the ports
+    template <typename T = Synapse>
+    class ProceduralProjection : public Projection {
+
+    public:
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        template <typename F, typename... Args>
+        ProceduralProjection(Network& _network, const layer& presynapticLayer, const layer& postsynapticLayer, F&& lambdaFunction, int _connection_ratio, Args&&... args) :
+                Projection(&_network, presynapticLayer.id, postsynapticLayer.id),
+                connection_ratio(_connection_ratio),
+                recurrent(presynapticLayer.id == postsynapticLayer.id),
+                pre_first(presynapticLayer.neurons.first),
+                pre_size(presynapticLayer.neurons.size()),
+                post_first(postsynapticLayer.neurons.first),
+                post_size(postsynapticLayer.neurons.size()),
+                max_delay(0) {
+
+            // error handling
+            if (connection_ratio <= 0 || connection_ratio > 100) {
+                throw std::logic_error("the connection ratio has to be within ]0, 100]");
+            }
+
+            if (pre_size == 0 || post_size == 0) {
+                throw std::logic_error("procedural projections connect two layers that already have neurons");
+            }
+
+            // every draw starts from a copy of the distribution so a connection does not depend on the ones drawn before it
+            distribution = [prototype = std::decay_t<F>(std::forward<F>(lambdaFunction))](int x, int y, int depth, philox_engine& engine) {
+                auto fresh = prototype;
+                return std::pair<float, float>(fresh(x, y, depth, engine));
+            };
+
+            // seeded networks regenerate the same connections for the same seed, the others take their key from the random engine of the network
+            if (network->is_construction_seeded()) {
+                key = philox_engine::mix(network->get_construction_seed() ^ philox_engine::mix((static_cast<std::uint64_t>(presynaptic_layer) << 32) | static_cast<std::uint32_t>(postsynaptic_layer)));
+            } else {
+                auto& random_engine = network->get_random_engine();
+                key = static_cast<std::uint64_t>(random_engine()) << 32;
+                key |= random_engine();
+            }
+
+            // the coordinates and sublayers handed to the distribution, by postsynaptic neuron
+            targets.reserve(post_size);
+            for (std::size_t port=0; port<post_size; ++port) {
+                auto& neuron = network->get_neurons()[network->get_neuron_index(static_cast<int>(post_first + port))];
+                targets.emplace_back(target{neuron->get_xy_coordinates().first, neuron->get_xy_coordinates().second, neuron->get_sublayer_id()});
+            }
+
+            for (std::size_t port=0; port<post_size; ++port) {
+                auto& neuron = network->get_neurons()[network->get_neuron_index(static_cast<int>(post_first + port))];
+                auto pre = recurrent && pre_size > 1 && port == 0 ? 1 : 0;
+                auto weight_delay = draw(pre_first + pre, port);
+                make_port<T>(neuron.get(), network->get_neuron_index(static_cast<int>(pre_first + pre)), weight_delay.first, weight_delay.second, args...);
+            }
+
+            // the longest delay is found once by regenerating every connection, to shift the runtime in the clock mode
+            std::mutex max_delay_mutex;
+            network->parallel_for(pre_size, [&](std::size_t begin, std::size_t end) {
+                float chunk_max_delay = 0;
+                for (auto pre=begin; pre<end; ++pre) {
+                    for_each_target(pre_first + pre, [&](std::size_t port) {
+                        chunk_max_delay = std::max(chunk_max_delay, draw(pre_first + pre, port).second);
+                    });
+                }
+                std::lock_guard<std::mutex> lock(max_delay_mutex);
+                max_delay = std::max(max_delay, chunk_max_delay);
+            });
+        }
+
+        virtual ~ProceduralProjection(){}
+
+        // ----- PUBLIC METHODS -----
+        virtual void propagate(double timestamp, int presynaptic_neuron) override {
+            auto pre_user = static_cast<std::size_t>(network->get_user_id(presynaptic_neuron));
+            for_each_target(pre_user, [&](std::size_t port) {
+                network->inject_spike(spike{timestamp + draw(pre_user, port).second, ports[port].get(), spike_type::generated, presynaptic_neuron});
+            });
+        }
+
+        virtual float get_weight(int presynaptic_neuron, std::size_t port) const override {
+            return draw(static_cast<std::size_t>(network->get_user_id(presynaptic_neuron)), port).first;
+        }
+
+        // calls f(port) for every postsynaptic neuron reached by the neuron created with the id pre_user. the rejected connections are skipped without being drawn
+        template <typename F>
+        void for_each_target(std::size_t pre_user, F&& f) const {
+            connection_sampler sampler(connection_sampling::bernoulli, connection_ratio, post_size, philox_engine(key, static_cast<std::uint32_t>(pre_user), std::numeric_limits<std::uint32_t>::max(), 1));
+            for (auto port=sampler.next_selected(0); port<post_size; port=sampler.next_selected(port+1)) {
+                if (recurrent && port == pre_user - pre_first) {
+                    continue;
+                }
+                f(port);
+            }
+        }
+
+        // ----- SETTERS AND GETTERS -----
+        int get_connection_ratio() const {
+            return connection_ratio;
+        }
+
+        virtual float get_max_delay() const override {
+            return max_delay;
+        }
+
+        virtual std::size_t get_memory_footprint() const override {
+            return sizeof(ProceduralProjection) + Projection::get_memory_footprint() + targets.capacity() * sizeof(target);
+        }
+
+    protected:
+
+        struct target {
+            int x;
+            int y;
+            int sublayer;
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        // weight and delay of the connection between the neuron created with the id pre_user and the postsynaptic neuron of a port, from the stream of that pair
+        std::pair<float, float> draw(std::size_t pre_user, std::size_t port) const {
+            philox_engine engine(key, static_cast<std::uint32_t>(pre_user), static_cast<std::uint32_t>(post_first + port), 0);
+            auto& t = targets[port];
+            return distribution(t.x, t.y, t.sublayer, engine);
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        int                                                                     connection_ratio;
+        bool                                                                    recurrent; // a layer connected to itself, without self-connections
+        std::size_t                                                             pre_first; // id given at construction to the first neuron of each layer
+        std::size_t                                                             pre_size;
+        std::size_t                                                             post_first;
+        std::size_t                                                             post_size;
+        std::uint64_t                                                           key;
+        float                                                                   max_delay;
+        std::vector<target>                                                     targets;
+        std::function<std::pair<float, float>(int, int, int, philox_engine&)>   distribution;
+    };
+}
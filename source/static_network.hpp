@@ -0,0 +1,123 @@
+/*
+ * static_network.hpp
+ * Hummus - spiking neural network simulator
+ *
+ * Created by Omar Oubari.
+ * Email: omar.oubari@inserm.fr
+ * Last Version: 18/10/2026
+ *
+ * Information: Network variant specialised at compile time on a set of neuron types. The event loops call the update methods of these types directly (non-virtual calls the compiler can inline), with one type tag per neuron resolved before the run. Neurons whose exact type is not in the set fall back to the virtual interface, so the whole Network API is kept.
+ *
+ * Usage: hummus::StaticNetwork<hummus::Parrot, hummus::CUBA_LIF> network;
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <typeinfo>
+#include <vector>
+
+#include "core.hpp"
+
+namespace hummus {
+
+    template <typename... Ts>
+    class StaticNetwork : public Network {
+
+        static_assert(sizeof...(Ts) > 0, "StaticNetwork needs at least one neuron type");
+        static_assert(sizeof...(Ts) < UINT8_MAX, "too many neuron types for the 8-bit type tags");
+
+    public:
+
+        // ----- CONSTRUCTOR AND DESTRUCTOR -----
+        using Network::Network;
+
+        virtual ~StaticNetwork(){}
+
+    protected:
+
+        // tag of the neurons handled through the virtual interface
+        static constexpr std::uint8_t dynamic_tag = UINT8_MAX;
+
+        // calls the neuron kernels through a switch on the type tag of each neuron
+        struct static_dispatch {
+            StaticNetwork* network;
+
+            void update(std::size_t idx, double timestamp, Synapse* s, float timestep, spike_type type) {
+                network->touch_neuron(idx);
+                Neuron* n = network->neurons[idx].get();
+                if (!update_as<false, Ts...>(network->neuron_tags[idx], n, timestamp, s, network, timestep, type)) {
+                    n->update(timestamp, s, network, timestep, type);
+                }
+            }
+
+            void update_sync(std::size_t idx, double timestamp, Synapse* s, float timestep, spike_type type) {
+                network->touch_neuron(idx);
+                Neuron* n = network->neurons[idx].get();
+                if (!update_as<true, Ts...>(network->neuron_tags[idx], n, timestamp, s, network, timestep, type)) {
+                    n->update_sync(timestamp, s, network, timestep, type);
+                }
+            }
+        };
+
+        // ----- IMPLEMENTATION METHODS -----
+        virtual void es_run_helper(double t, int x, int y, int x_min, int y_min, bool classification=false) override {
+            assign_neuron_tags();
+            static_dispatch dispatch{this};
+            es_run_loop(dispatch, t, x, y, x_min, y_min, classification);
+        }
+
+        virtual void async_run_helper(std::atomic_bool* running, bool classification=false, bool eof=false) override {
+            assign_neuron_tags();
+            static_dispatch dispatch{this};
+            async_run_loop(dispatch, running, classification, eof);
+        }
+
+        virtual void sync_run_helper(std::atomic_bool* running, double runtime, float timestep, bool classification=false) override {
+            assign_neuron_tags();
+            static_dispatch dispatch{this};
+            sync_run_loop(dispatch, running, runtime, timestep, classification);
+        }
+
+        // neurons are only ever appended and keep their type, so tags are computed once for every new neuron. the exact type has to match: a class deriving from one of Ts may override update
+        void assign_neuron_tags() {
+            if (neuron_tags.size() == neurons.size()) {
+                return;
+            }
+
+            const std::type_info* types[] = {&typeid(Ts)...};
+            neuron_tags.resize(neurons.size(), dynamic_tag);
+            for (std::size_t i=0; i<neurons.size(); ++i) {
+                neuron_tags[i] = dynamic_tag;
+                for (std::uint8_t t=0; t<sizeof...(Ts); ++t) {
+                    if (typeid(*neurons[i].get()) == *types[t]) {
+                        neuron_tags[i] = t;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // qualified calls bypass the vtable. returns false when the tag doesn't belong to the type set
+        template <bool sync, typename T, typename... Rest>
+        static bool update_as(std::uint8_t tag, Neuron* n, double timestamp, Synapse* s, Network* network, float timestep, spike_type type) {
+            if (tag == 0) {
+                if constexpr (sync) {
+                    static_cast<T*>(n)->T::update_sync(timestamp, s, network, timestep, type);
+                } else {
+                    static_cast<T*>(n)->T::update(timestamp, s, network, timestep, type);
+                }
+                return true;
+            }
+
+            if constexpr (sizeof...(Rest) > 0) {
+                return update_as<sync, Rest...>(tag - 1, n, timestamp, s, network, timestep, type);
+            } else {
+                return false;
+            }
+        }
+
+        // ----- IMPLEMENTATION VARIABLES -----
+        std::vector<std::uint8_t>               neuron_tags;
+    };
+}
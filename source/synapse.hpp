@@ -11,6 +11,11 @@
 
 #pragma once
 
+#include <cstddef>
+
+#include "checkpoint.hpp"
+#include "memory_policy.hpp"
+
 namespace hummus {
     // synapse models enum for readability
     enum class synapse_type {
@@ -31,10 +36,32 @@ namespace hummus {
                 synaptic_current(0),
                 synaptic_potential(0),
                 synapse_time_constant(_synapse_time_constant),
-                previous_input_time(0) {}
+                previous_input_time(0),
+                postsynaptic_layer(-1) {}
 
         virtual ~Synapse(){}
 
+        // synapses are carved from the arena of the neuron pool that owns them (see synapse_arena). the ones created with a plain new live on the heap
+        static void* operator new(std::size_t size) {
+            return synapse_arena::allocate(nullptr, size);
+        }
+
+        static void* operator new(std::size_t size, synapse_arena* arena) {
+            return synapse_arena::allocate(arena, size);
+        }
+
+        // the destructor being virtual, size is the one of the synapse model
+        static void operator delete(void* synapse, std::size_t size) {
+            synapse_arena::deallocate(synapse, size);
+        }
+
+        // only called when a constructor throws. a block taken from an arena stays there until the arena is destroyed
+        static void operator delete(void* synapse, synapse_arena* arena) {
+            if (!arena) {
+                synapse_arena::deallocate(synapse, 0);
+            }
+        }
+
         // ----- PUBLIC SYNAPSE METHODS -----
 
         // pure virtual method that updates the current value in the absence of a spike
@@ -53,12 +80,35 @@ namespace hummus {
         virtual void soft_reset() {
             synaptic_current = 0;
         }
+
+        // called before delivering a spike that went through a projection, with the neuron that sent it
+        virtual void route_from(int presynaptic_neuron) {}
+
+        // saves or loads the parameters and state of the synapse (see Network::save_checkpoint). synapse models with their own parameters extend it
+        virtual void serialise(state_archive& archive) {
+            archive(presynaptic_neuron, postsynaptic_neuron, efficacy, weight, delay, synaptic_current, synaptic_potential, synapse_time_constant, previous_input_time, postsynaptic_layer, type);
+        }
         
         // ----- SETTERS AND GETTERS -----
         synapse_type get_type() const {
             return type;
         }
 
+        // name of the synapse model, used to group synapses in memory reports
+        virtual const char* get_model_name() const {
+            return "Synapse";
+        }
+
+        // size of the synapse object
+        virtual std::size_t get_memory_footprint() const {
+            return sizeof(Synapse);
+        }
+
+        // part of the synapse object taken by its own random engine
+        virtual std::size_t get_random_engine_footprint() const {
+            return 0;
+        }
+
         float get_synaptic_potential() const {
             return synaptic_potential;
         }
@@ -79,10 +129,27 @@ namespace hummus {
             return presynaptic_neuron;
         }
 
+        void set_presynaptic_neuron_id(int new_id) {
+            presynaptic_neuron = new_id;
+        }
+
         int get_postsynaptic_neuron_id() const {
             return postsynaptic_neuron;
         }
 
+        void set_postsynaptic_neuron_id(int new_id) {
+            postsynaptic_neuron = new_id;
+        }
+
+        // layer of the postsynaptic neuron, cached so the firing path doesn't have to look the neuron up
+        int get_postsynaptic_layer_id() const {
+            return postsynaptic_layer;
+        }
+
+        void set_postsynaptic_layer_id(int new_id) {
+            postsynaptic_layer = new_id;
+        }
+
         float get_weight() const {
             return weight;
         }
@@ -144,6 +211,7 @@ namespace hummus {
         float                      synaptic_potential;
         float                      synapse_time_constant;
         double                     previous_input_time;
+        int                        postsynaptic_layer;
         synapse_type               type;
     };
 }
@@ -34,10 +34,8 @@ namespace hummus {
                 throw std::logic_error("The current decay value cannot be less than or equal to 0");
             }
 
-			// initialising a normal distribution
-            std::random_device device;
-            random_engine = std::mt19937(device());
-            normal_distribution = std::normal_distribution<float>(0, _gaussian_std_dev);
+            // initialising a normal distribution
+            set_noise(_gaussian_std_dev);
 
             // current-based synapse figuring out if excitatory or inhibitory
             if (_weight < 0) {
@@ -62,7 +60,40 @@ namespace hummus {
             synaptic_current += efficacy * weight * (external_current+normal_distribution(random_engine));
 		}
 
+        // the random engine is seeded again rather than saved
+        virtual void serialise(state_archive& archive) override {
+            Synapse::serialise(archive);
+            float gaussian_std_dev = normal_distribution.stddev();
+            archive(inv_s_tau, external_current, gaussian_std_dev);
+            if (archive.is_loading()) {
+                set_noise(gaussian_std_dev);
+            }
+        }
+
+		// ----- SETTERS AND GETTERS -----
+        virtual const char* get_model_name() const override {
+            return "Exponential";
+        }
+
+        virtual std::size_t get_memory_footprint() const override {
+            return sizeof(Exponential);
+        }
+
+        virtual std::size_t get_random_engine_footprint() const override {
+            return sizeof(random_engine);
+        }
+
 	protected:
+
+        // without noise the random engine is never read, so it keeps its default seed instead of being seeded from the system
+        void set_noise(float gaussian_std_dev) {
+            normal_distribution = std::normal_distribution<float>(0, gaussian_std_dev);
+            if (gaussian_std_dev != 0) {
+                std::random_device device;
+                random_engine = std::mt19937(device());
+            }
+        }
+
         float                            inv_s_tau;
 		std::mt19937                     random_engine;
 		std::normal_distribution<float>  normal_distribution;
@@ -48,7 +48,25 @@ namespace hummus {
             synaptic_potential = 0;
             synaptic_current = 0;
         }
-        
+
+        virtual void serialise(state_archive& archive) override {
+            Synapse::serialise(archive);
+            archive(current_sign);
+        }
+
+		// ----- SETTERS AND GETTERS -----
+        virtual const char* get_model_name() const override {
+            return "Memristor";
+        }
+
+        virtual std::size_t get_memory_footprint() const override {
+            return sizeof(Memristor);
+        }
+
+        virtual std::size_t get_random_engine_footprint() const override {
+            return sizeof(random_engine);
+        }
+
     protected:
         std::mt19937                     random_engine;
         std::normal_distribution<float>  normal_distribution;